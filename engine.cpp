@@ -1,14 +1,13 @@
 #include "engine.h"
 
-enum state {start, settings, play, over};
-state screen;
-
 // Colors
 color originalFill, hoverFill, pressFill;
 
 
-Engine::Engine() : keys() {
+Engine::Engine(PacingMode pacing, double fpsCap, uint64_t seed, TargetStyle targetStyle)
+        : framePacer(pacing, fpsCap), seed(seed), targetStyle(targetStyle) {
     this->initWindow();
+    input = make_unique<InputSystem>(window);
     this->initShaders();
     this->initShapes();
 
@@ -16,10 +15,30 @@ Engine::Engine() : keys() {
     hoverFill.vec = originalFill.vec + vec4{0.5, 0.5, 0.5, 0};
     pressFill.vec = originalFill.vec - vec4{0.5, 0.5, 0.5, 0};
 
-    startTime = glfwGetTime();
+    // the game logic runs on its own thread from here on, 1000 ticks per second
+    simulation = make_unique<Simulation>(width, height, seed);
+    previousSnapshot = simulation->getSnapshots().front();
 }
 
-Engine::~Engine() {}
+Engine::~Engine() {
+    // stop the game logic before anything it could be handed input from goes away
+    simulation.reset();
+
+    // stop background loading first, its tasks still point into the managers below
+    assetLoader.reset();
+
+    // how evenly the frames were paced over the session
+    FramePacer::Stats pacing = framePacer.getStats();
+    if (pacing.frames > 0)
+        cout << "| FRAMEPACER: " << pacing.frames << " frames, interval mean " << pacing.mean << " ms, jitter "
+             << pacing.jitter << " ms, min " << pacing.min << " ms, max " << pacing.max << " ms" << endl;
+    // how well the render queue batched the frames' draws
+    if (drawnFrames > 0)
+        cout << "| RENDERQUEUE: " << static_cast<double>(drawCalls) / drawnFrames << " draw calls per frame" << endl;
+
+    // shared shape meshes are owned by the registry, not by the shapes
+    MeshRegistry::instance().clear();
+}
 
 unsigned int Engine::initWindow(bool debug) {
     // glfw: initialize and configure
@@ -47,373 +66,203 @@ unsigned int Engine::initWindow(bool debug) {
     glViewport(0, 0, width, height);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glfwSwapInterval(1);
+    // vsync, uncapped or capped, as chosen on the command line
+    framePacer.apply();
 
     return 0;
 }
 
 void Engine::initShaders() {
+    // Shaders and the font load on a background thread with a shared context, so the first
+    // frame is presented right away; anything drawn with an asset that isn't ready yet is skipped
+    assetLoader = make_unique<AssetLoader>(window);
+
     // load shader manager
-    shaderManager = make_unique<ShaderManager>();
+    shaderManager = make_unique<ShaderManager>(assetLoader.get());
 
-    // Load shader into shader manager and retrieve it
-    shapeShader = this->shaderManager->loadShader("../res/shaders/shape.vert", "../res/shaders/shape.frag",  nullptr, "shape");
+    // Queue every shader at once so the driver can compile them in parallel, and keep references
+    // (the entries in the shader manager become ready in place)
+    shapeShader = &shaderManager->loadShaderAsync("../res/shaders/shape.vert", "../res/shaders/shape.frag",  nullptr, "shape");
+    textShader = &shaderManager->loadShaderAsync("../res/shaders/text.vert", "../res/shaders/text.frag", nullptr, "text");
+    targetShader = &shaderManager->loadShaderAsync("../res/shaders/target.vert", "../res/shaders/target.frag", nullptr, "target");
 
-    // Configure text shader and renderer
-    textShader = shaderManager->loadShader("../res/shaders/text.vert", "../res/shaders/text.frag", nullptr, "text");
-    fontRenderer = make_unique<FontRenderer>(shaderManager->getShader("text"), "../res/fonts/MxPlus_IBM_BIOS.ttf", 24);
+    // Streaming vertex memory and the draw queue shared by the text and target renderers
+    streamBuffer = make_unique<StreamBuffer>(1 << 22);
+    renderQueue = make_unique<RenderQueue>();
 
-    // Set uniforms
-    textShader.setVector2f("vertex", vec4(100, 100, .5, .5));
-    shapeShader.use();
-    shapeShader.setMatrix4("projection", this->PROJECTION);
+    // Configure text renderer
+    // (the font's ASCII atlas is baked on the first run and mapped from disk after that, all on the loader)
+    fontRenderer = make_unique<FontRenderer>(*textShader, *streamBuffer, *renderQueue, assetLoader.get(), "../res/fonts/MxPlus_IBM_BIOS.ttf", 24);
 
+    // Instanced quad shader and renderer for the targets (the circles are computed per pixel)
+    targetRenderer = make_unique<TargetBatchRenderer>(*targetShader, *streamBuffer, *renderQueue);
+    targetRenderer->setStyle(targetStyle);
+
+    // The crosshair is a plain shape drawn outside the queue, so it can be placed at the last moment
+    crosshair = make_unique<CrosshairRenderer>(*shapeShader);
+
+    // Projection and view are shared by every shader through the per-frame uniform block
+    frameUniforms = make_unique<FrameUniforms>();
 }
 
 void Engine::initShapes() {
     //Initializing the sliders. Spawnbutton isnt a slider, but I found that I needed it for the program to run
     //there is a slider (shape instance) for the size of the target, the time you get per spawn round,
     //the number of targets, and the total time of the program.
-    spawnButton = make_unique<Rect>(shapeShader, vec2{width/2,height/2}, vec2{100, 50}, color{1, 0, 0, 1});
-    sizeButton = make_unique<Rect>(shapeShader, vec2{width/2,11.5*height/16}, vec2{80, 80}, color{1, 0, 0, 1});
-    speedButton = make_unique<Rect>(shapeShader, vec2{width/2,8.5*height/16}, vec2{80, 80}, color{0, 1, 0, 1});
-    countButton = make_unique<Rect>(shapeShader, vec2{width/2,5.5*height/16}, vec2{80, 80}, color{0, 0, 1, 1});
-    timeButton = make_unique<Rect>(shapeShader, vec2{width/2,2.5*height/16}, vec2{80, 80}, color{1, 1, 1, 1});
+    spawnButton = make_unique<Rect>(*shapeShader, vec2{width/2,height/2}, vec2{100, 50}, color{1, 0, 0, 1});
+    sizeButton = make_unique<Rect>(*shapeShader, vec2{width/2,11.5*height/16}, vec2{80, 80}, color{1, 0, 0, 1});
+    speedButton = make_unique<Rect>(*shapeShader, vec2{width/2,8.5*height/16}, vec2{80, 80}, color{0, 1, 0, 1});
+    countButton = make_unique<Rect>(*shapeShader, vec2{width/2,5.5*height/16}, vec2{80, 80}, color{0, 0, 1, 1});
+    timeButton = make_unique<Rect>(*shapeShader, vec2{width/2,2.5*height/16}, vec2{80, 80}, color{1, 1, 1, 1});
 }
 
-void Engine::processInput() {
-    glfwPollEvents();
-
-    //variables for timing purposes
-    float currentFrame = glfwGetTime();
-    lastFrame = currentFrame;
-
+void Engine::run() {
+    // the render thread takes the context; GLFW's events can only be pumped here, on the main thread
+    glfwMakeContextCurrent(nullptr);
+    rendering.store(true, std::memory_order_release);
+    renderThread = std::thread(&Engine::renderLoop, this);
 
-    // Set keys to true if pressed, false if released
-    for (int key = 0; key < 1024; ++key) {
-        if (glfwGetKey(window, key) == GLFW_PRESS)
-            keys[key] = true;
-        else if (glfwGetKey(window, key) == GLFW_RELEASE)
-            keys[key] = false;
-    }
-
-    // Close window if escape key is pressed, extended to the stats window
-    if (keys[GLFW_KEY_ESCAPE])
-        glfwSetWindowShouldClose(window, true);
-
-    if (keys[GLFW_KEY_ESCAPE])
-        glfwSetWindowShouldClose(stats, true);
-
-
-    // Mouse position saved to check for collisions
-    glfwGetCursorPos(window, &MouseX, &MouseY);
-    //if the user is in the start screen, an 's' input transitions to the settings screen,
-    //and initializes the settings time variable
-    if(screen == start) {
-        if (keys[GLFW_KEY_S]) {
-            screen = settings;
-            settingsTime = glfwGetTime();
-        }
-    }
-
-    //logic check that transitions the game if the user has spent 20 seconds on settings
-    if(screen == settings) {
-        float currentFrame = glfwGetTime();
-        if (keys[GLFW_KEY_G] || currentFrame - settingsTime >= 20.0) {
-            startTime = currentFrame;
-            screen = play;
-        }
-    }
-
-    //variable to adequately find the mouse's y component
-    MouseY = height - MouseY;
-    //variable for if the user presses the left mouse button
-    bool press = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-
-    //the logic for the size slider
-    if(screen == settings) {
-        //if the mouse is overlapping the size slider, it changes color
-        if(sizeButton ->isOverlappingY(vec2(MouseX, MouseY))) {
-            //variable to access the mouse's position
-            vec2 mouse(MouseX, MouseY);
-            sizeButton->setColor(hoverFill);
-
-            //code to move slider with arrow keys
-            if (keys[GLFW_KEY_LEFT])
-                sizeButton->moveX(-3.80f);
-            if (keys[GLFW_KEY_RIGHT])
-                sizeButton->moveX(3.80f);
-
-            //setting boundaries for the size slider
-            if(sizeButton->getPosX() < 1.8*width/8){
-                sizeButton->setPosX(1.8*width/8);
-            }
-            if(sizeButton->getPosX() > 6.2*width/8) {
-                sizeButton->setPosX(6.2*width/8);
-            }
-
-            //logic to allow the mouse to also dictate the slider's position
-            if(mouse.x > 1.8*width/8 && mouse.x < 6.2*width/8 && press) {
-                sizeButton->setPosX(mouse.x);
-            }
-
-            //if the slider moves, update it's corresponding finalSize variable
-            finalSize = value(sizeButton->getPosX(),"size");
-
-        }
-        else {
-            //making sure that the color goes back to normal if not hovered on
-            sizeButton->setColor(color{1, 0, 0, 1});
-        }
-
-        //slider for speed
-        if(screen == settings) {
-            if(speedButton ->isOverlappingY(vec2(MouseX, MouseY))) {
-                //vector of mouse position
-                vec2 mouse(MouseX, MouseY);
-                speedButton->setColor(hoverFill);
-
-                //allowing arrow keys to move the slider, if the mouse is hovering at the same horizontal
-                //level
-                if (keys[GLFW_KEY_LEFT])
-                    speedButton->moveX(-3.80f);
-                if (keys[GLFW_KEY_RIGHT])
-                    speedButton->moveX(3.80f);
-
-                //movement boundaries
-                if(speedButton->getPosX() < 1.8*width/8){
-                    speedButton->setPosX(1.8*width/8);
-                }
-                if(speedButton->getPosX() > 6.2*width/8) {
-                    speedButton->setPosX(6.2*width/8);
-                }
-                //allowing the mouse to dictate slider position
-                if(mouse.x > 1.8*width/8 && mouse.x < 6.2*width/8 && press) {
-                    speedButton->setPosX(mouse.x);
-                }
-                //updating the finalSpeed variable
-                finalSpeed = value(speedButton->getPosX(),"speed");
-            }
-            else {
-                //if not hovered upon, change the color back to normal
-                speedButton->setColor(color{0, 1, 0, 1});
-            }
-        }
-
-        //slider for the targetCount Variable
-        if(screen == settings) {
-            if(countButton ->isOverlappingY(vec2(MouseX, MouseY))) {
-                //if the user hovers over the horizontal of the slider, change the color
-                vec2 mouse(MouseX, MouseY);
-                countButton->setColor(hoverFill);
-
-                //move the slider with the arrow keys
-                if (keys[GLFW_KEY_LEFT])
-                    countButton->moveX(-3.80f);
-                if (keys[GLFW_KEY_RIGHT])
-                    countButton->moveX(3.80f);
-
-                //movement boundaries
-                if(countButton->getPosX() < 1.8*width/8){
-                    countButton->setPosX(1.8*width/8);
-                }
-                if(countButton->getPosX() > 6.2*width/8) {
-                    countButton->setPosX(6.2*width/8);
-                }
-
-                //move the sliders with the mouse
-                if(mouse.x > 1.8*width/8 && mouse.x < 6.2*width/8 && press) {
-                    countButton->setPosX(mouse.x);
-                }
-                //updating the final count variable
-                finalCount = value(countButton->getPosX(),"count");
-            }
-            else {
-                //if not hovered upon, change the color back to normal
-                countButton->setColor(color{0, 0, 1, 1});
-            }
-        }
-
-        //slider for the time variable
-        if(screen == settings) {
-            if(timeButton ->isOverlappingY(vec2(MouseX, MouseY))) {
-                //hovering over this button's y values causes a change in color
-                vec2 mouse(MouseX, MouseY);
-                timeButton->setColor(hoverFill);
-
-                //moving the slider with the keys
-                if (keys[GLFW_KEY_LEFT])
-                    timeButton->moveX(-3.80f);
-                if (keys[GLFW_KEY_RIGHT])
-                    timeButton->moveX(3.80f);
-
-                //movement boundaries
-                if(timeButton->getPosX() < 1.8*width/8){
-                    timeButton->setPosX(1.8*width/8);
-                }
-                if(timeButton->getPosX() > 6.2*width/8) {
-                    timeButton->setPosX(6.2*width/8);
-                }
-
-                //mouse input changes the slider location
-                if(mouse.x > 1.8*width/8 && mouse.x < 6.2*width/8 && press) {
-                    timeButton->setPosX(mouse.x);
-                }
-                //updating the final time variable
-                finalTime = value(timeButton->getPosX(),"time");
-            }
-            else {
-                //making sure the color goes back to normal if not hovered on
-                timeButton->setColor(color{1, 1, 1, 1});
-            }
-        }
+    while (!shouldClose()) {
+        processInput();
     }
 
-    //incrementing the misses variable if the user clicks not on a confetti circle
-    if(screen == play) {
-        for (unique_ptr<Shape>& circle : confetti) {
-            if (!(circle->isOverlapping(vec2(MouseX, MouseY)))&&press) {
-                misses++;
-            }
-        }
-    }
+    rendering.store(false, std::memory_order_release);
+    renderThread.join();
+    // ~Engine runs on this thread too (before main terminates GLFW), so the renderers delete their GL objects with the context current
+    glfwMakeContextCurrent(window);
+}
 
+void Engine::renderLoop() {
+    glfwMakeContextCurrent(window);
+    // the swap interval belongs to the thread's current context
+    framePacer.apply();
 
-    //iterating through the vector of shapes to see If the mouse is overlapping with any of them,
-    //then outputting the time it took to get each;
-    //calculating time
-    currentFrame = glfwGetTime();
-    lastFrame = currentFrame;
-    for (unique_ptr<Shape>& circle : confetti) {
-        //change the circle's color to let the user know that they are hovering in the right place
-        if (circle->isOverlapping(vec2(MouseX, MouseY))) {
-            circle->setColor(hoverFill);
-        }
-        //if the user clicks the circle, then move the circle off the map, to represent deleting it,
-        //and incrementing the score variable
-        if (circle->isOverlapping(vec2(MouseX, MouseY)) && press) {
-            circle->setPosX(-1000);
-            gotchaCount++;
-        }
+    while (rendering.load(std::memory_order_acquire)) {
+        render();
     }
 
-    //mouse is clicked variable
-    mousePressedLastFrame = press;
-
-    //if the game is in the over state, and the user clicks the a key, then the game restarts, for a
-    //continuous training loop
-    if(screen == over) {
-        if (keys[GLFW_KEY_A]) {
-            screen = start;
-        }
-    }
+    glfwMakeContextCurrent(nullptr);
 }
 
-void Engine::update() {
-    //calculate time
-    float currentFrame = glfwGetTime();
-    lastFrame = currentFrame;
+void Engine::processInput() {
+    // Wait for events (at most inputPeriod); the input system's callbacks stamp every key, button and cursor event
+    input->poll(inputPeriod);
 
+    // Close window if escape key is pressed, extended to the stats window
+    if (input->isKeyDown(GLFW_KEY_ESCAPE))
+        glfwSetWindowShouldClose(window, true);
 
-    //this logic represents the spawning of the next batch of targets. if the time from the last spawn
-    //of confetti exceeds the user dictated finalSpeed variable, the next batch is spawned, and the last
-    //spawn variable is updated
-    if(currentFrame - lastSpawn >= finalSpeed) {
-        confetti.clear();
-        for(int i = 0; i < finalCount; i++) {
-            spawnConfetti();
-        }
-        lastSpawn = currentFrame;
-    }
+    if (input->isKeyDown(GLFW_KEY_ESCAPE))
+        glfwSetWindowShouldClose(stats, true);
 
-    //variable for time spent in the game portion of the program, for help timing
-    if (screen == play) {
-        gameTime = currentFrame - startTime;
-    }
+    // The crosshair replaces the OS cursor: hidden over the menus, captured during a round so the
+    // aim uses raw motion and can't leave the window
+    input->setCursorMode(simulation->getScreen() == Screen::Play ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_HIDDEN);
 
-    //this logic checks if while the program is in the game state and the time in the game portion
-    //exceeds the user-defined finalTime variable, then the game is over, and the screen is switched to
-    //the endgame screen
-    if (screen == play && gameTime >= finalTime) {
-        confetti.clear();
-        screen = over;
-    }
+    // Everything else (screens, sliders, hovering, hits) is game logic: the simulation applies the
+    // events at the times they were stamped with, whatever the frame rate
+    simulation->post(input->getEvents());
 }
 
 void Engine::render() {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Set background color
     glClear(GL_COLOR_BUFFER_BIT);
 
-    // Set shader to draw shapes
-    shapeShader.use();
+    // Pick up the shaders that finished loading in the background
+    shaderManager->update();
+
+    // Upload the per-frame uniforms once for every shader
+    frameUniforms->update({PROJECTION, mat4(1.0f), vec4(0, 0, width, height), static_cast<float>(glfwGetTime())});
+
+    // Take the newest tick of the simulation, keeping the one before it to interpolate from
+    TripleBuffer<GameSnapshot>& snapshots = simulation->getSnapshots();
+    if (snapshots.hasFresh()) {
+        previousSnapshot = snapshots.front();
+        snapshots.update();
+    }
+    const GameSnapshot& snapshot = snapshots.front();
+
+    // Show the game one tick in the past, blended between the two snapshots around that time, so
+    // whatever moves does so smoothly however the frames and ticks line up
+    float alpha = 1.0f;
+    if (snapshot.time > previousSnapshot.time && snapshot.screen == previousSnapshot.screen) {
+        double shown = InputSystem::now() - simulation->getTickPeriod();
+        alpha = static_cast<float>(glm::clamp((shown - previousSnapshot.time) / (snapshot.time - previousSnapshot.time), 0.0, 1.0));
+    }
+    auto interpolate = [alpha](float from, float to) { return from + (to - from) * alpha; };
 
     // Render differently depending on screen
-    switch (screen) {
-        case start: {
+    // (everything is recorded into the render queue, then sorted and submitted at once)
+    switch (snapshot.screen) {
+        case Screen::Start: {
             //the main menu/entrance screen, welcoming the user. an s moves the screen to the next case
             string message = "Welcome to the Aim Trainer!";
-            this->fontRenderer->renderText(message, width/2 - (12 * message.length()), height/2, projection, 1, vec3{1, 1, 1});
-            this->fontRenderer->renderText("Press s to start!", width/2 - (12 * message.length()) + 80, (height/2)-40, projection, 1, vec3{1, 1, 1});
+            this->fontRenderer->renderStaticText(message, width/2 - (12 * message.length()), height/2, 1, vec3{1, 1, 1});
+            this->fontRenderer->renderStaticText("Press s to start!", width/2 - (12 * message.length()) + 80, (height/2)-40, 1, vec3{1, 1, 1});
             break;
         }
-        case settings: {
+        case Screen::Settings: {
             //this screen case represents the user's choosing of the settings. the user is greeted, then
             //when they press g or twenty seconds have passed, then the screen is progressed to the game stage
-            this->fontRenderer->renderText("Click G to start training!", 400, 750, projection, 1, vec3{1, 1, 1});
-            this->fontRenderer->renderText("Adjust the sliders for difficulty", 375, 675, projection, 1, vec3{1, 1, 1});
-            //sliders for the buttons
+            this->fontRenderer->renderStaticText("Click G to start training!", 400, 750, 1, vec3{1, 1, 1});
+            this->fontRenderer->renderStaticText("Adjust the sliders for difficulty", 375, 675, 1, vec3{1, 1, 1});
+            //sliders for the buttons, placed where the simulation has them. a slider changes color while hovered
+            Shape* buttons[4] = {sizeButton.get(), speedButton.get(), countButton.get(), timeButton.get()};
+            const color colors[4] = {color{1, 0, 0, 1}, color{0, 1, 0, 1}, color{0, 0, 1, 1}, color{1, 1, 1, 1}};
+            for (int i = 0; i < 4; i++) {
+                const Slider& slider = snapshot.sliders[i];
+                buttons[i]->setPos(vec2(interpolate(previousSnapshot.sliders[i].pos.x, slider.pos.x), slider.pos.y));
+                buttons[i]->setColor(slider.hovered ? hoverFill : colors[i]);
+            }
+            //the labels move with their sliders, so they are laid out each frame instead of cached
 
             //rendering the size slider
-            shapeShader.use();
-            sizeButton->setUniforms();
-            sizeButton->draw();
-            fontRenderer->renderText("Size", sizeButton->getPos().x - 40, sizeButton->getPos().y - 5, projection, 0.5, vec3{1, 1, 1});
+            sizeButton->submit(*renderQueue, RenderLayer::Widgets);
+            fontRenderer->renderText("Size", sizeButton->getPos().x - 40, sizeButton->getPos().y - 5, 0.5, vec3{1, 1, 1});
 
             //rendering the shape slider
-            shapeShader.use();
-            speedButton->setUniforms();
-            speedButton->draw();
-            fontRenderer->renderText("speed", speedButton->getPos().x - 40, speedButton->getPos().y - 5, projection, 0.5, vec3{1, 1, 1});
+            speedButton->submit(*renderQueue, RenderLayer::Widgets);
+            fontRenderer->renderText("speed", speedButton->getPos().x - 40, speedButton->getPos().y - 5, 0.5, vec3{1, 1, 1});
 
             //rendering the target count slider
-            shapeShader.use();
-            countButton->setUniforms();
-            countButton->draw();
-            fontRenderer->renderText("targets", countButton->getPos().x - 40, countButton->getPos().y - 5, projection, 0.5, vec3{1, 1, 1});
+            countButton->submit(*renderQueue, RenderLayer::Widgets);
+            fontRenderer->renderText("targets", countButton->getPos().x - 40, countButton->getPos().y - 5, 0.5, vec3{1, 1, 1});
 
             //rendering the time slider
-            shapeShader.use();
-            timeButton->setUniforms();
-            timeButton->draw();
-            fontRenderer->renderText("time", timeButton->getPos().x - 40, timeButton->getPos().y - 5, projection, 0.5, vec3{0, 0, 0});
+            timeButton->submit(*renderQueue, RenderLayer::Widgets);
+            fontRenderer->renderText("time", timeButton->getPos().x - 40, timeButton->getPos().y - 5, 0.5, vec3{0, 0, 0});
 
             break;
         }
-        case play: {
+        case Screen::Play: {
             //the case for when the game is being played
-            //drawing all the confetti pieces initialized previously
-            for (unique_ptr<Shape> &piece : confetti) {
-                piece->setUniforms();
-                piece->draw();
+            //drawing all the confetti pieces of the snapshot, batched into one instanced draw
+            targetRenderer->begin();
+            const TargetStore& targets = snapshot.targets;
+            for (unsigned int i = 0; i < targets.size(); i++) {
+                targetRenderer->add(targets.getPos(i), vec2(2.0f * targets.getRadius(i)), targets.isHovered(i) ? hoverFill.vec : targets.getColor(i));
             }
+            targetRenderer->draw();
 
-            //a live countdown of the time remaining in the program, and your score
-            fontRenderer->renderText(std::to_string(finalTime - gameTime), width/200, height/200, projection, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText(std::to_string(gotchaCount), width/8, height/200, projection, 0.5, vec3{1, 1, 1});
-
-            //calculating the user's clicking accuracy
-            accuracy = gotchaCount / float(gotchaCount+misses);
+            //a live countdown of the time remaining in the program, and your score. These change every
+            //frame, so they skip the layout cache the other text goes through
+            fontRenderer->renderText(std::to_string(interpolate(previousSnapshot.timeLeft, snapshot.timeLeft)), width/200, height/200, 0.5, vec3{1, 1, 1});
+            fontRenderer->renderText(std::to_string(snapshot.hits), width/8, height/200, 0.5, vec3{1, 1, 1});
 
             break;
         }
-        case over: {
+        case Screen::Over: {
             //case for when the game is completed
             //a concluding message is rendered, then the user's stats.
-            fontRenderer->renderText("Nice Training!", spawnButton->getPos().x - 30, spawnButton->getPos().y - 5, projection, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText("Enter 'a' to Play Again!", spawnButton->getPos().x - 30, spawnButton->getPos().y - 30, projection, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText("Time completed: " + std::to_string(finalTime), spawnButton->getPos().x - 30, spawnButton->getPos().y - 50, projection, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText("Targets Clicked: " + std::to_string(gotchaCount), spawnButton->getPos().x - 30, spawnButton->getPos().y - 70, projection, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText("Click Accuracy: " + std::to_string(accuracy) + "%", spawnButton->getPos().x - 30, spawnButton->getPos().y - 90, projection, 0.5, vec3{1, 1, 1});
+            fontRenderer->renderStaticText("Nice Training!", spawnButton->getPos().x - 30, spawnButton->getPos().y - 5, 0.5, vec3{1, 1, 1});
+            fontRenderer->renderStaticText("Enter 'a' to Play Again!", spawnButton->getPos().x - 30, spawnButton->getPos().y - 30, 0.5, vec3{1, 1, 1});
+            fontRenderer->renderStaticText("Time completed: " + std::to_string(snapshot.finalTime), spawnButton->getPos().x - 30, spawnButton->getPos().y - 50, 0.5, vec3{1, 1, 1});
+            fontRenderer->renderStaticText("Targets Clicked: " + std::to_string(snapshot.hits), spawnButton->getPos().x - 30, spawnButton->getPos().y - 70, 0.5, vec3{1, 1, 1});
+            fontRenderer->renderStaticText("Click Accuracy: " + std::to_string(snapshot.accuracy) + "%", spawnButton->getPos().x - 30, spawnButton->getPos().y - 90, 0.5, vec3{1, 1, 1});
+            if (snapshot.hits > 0) {
+                int reaction = int(1000.0 * snapshot.reactionTotal / snapshot.hits);
+                fontRenderer->renderStaticText("Mean Reaction: " + std::to_string(reaction) + " ms", spawnButton->getPos().x - 30, spawnButton->getPos().y - 110, 0.5, vec3{1, 1, 1});
+            }
 
             //[BUGGED] if stats window hasn't been initialized yet, then it is initialized and (hopefully)
             //the stats window is generated and shown - I commented this out to allow the main gameplay loop to
@@ -423,32 +272,31 @@ void Engine::render() {
              //     statsWindow();
              //     //I think this allows the computer to know what screen on which to render the text
              //     glfwMakeContextCurrent(stats);
-             //     textShader.use();
+             //     textShader->use();
              //     //showing the user's stats
-             //     fontRenderer->renderText("Time completed: " + std::to_string(finalTime), newWidth/8, newHeight/8 , projection, 1.0, vec3(1, 1, 1));
+             //     fontRenderer->renderText("Time completed: " + std::to_string(finalTime), newWidth/8, newHeight/8 , 1.0, vec3(1, 1, 1));
              // }
-
-            //resetting the score and misses for the next round
-            gotchaCount = 0;
-            misses = 0;
+            //(the simulation resets the score when the next round starts)
         }
     }
 
-    glfwSwapBuffers(window);
-}
+    // Draw the frame with the fewest state changes
+    renderQueue->flush();
+    drawCalls += renderQueue->getDrawCalls();
+    drawnFrames++;
 
-void Engine::spawnConfetti() {
-    //Reusing the spawnConfetti program to spawn a vector of shootable targets
-    //random colors are selected
-    vec2 pos = {rand() % (int)width, rand() % (int)height};
-    //all targets are the same size, dictated by the user
-    vec2 size = {finalSize, finalSize};
-
-    color color = {float(rand() % 10 / 10.0), float(rand() % 10 / 10.0), float(rand() % 10 / 10.0), 1.0f};
-    //populating the list of confetti
-    confetti.push_back(make_unique<Circle>(shapeShader, pos, size, color));
+    // Protect everything streamed this frame until the GPU has consumed it, and drop stale text layouts
+    streamBuffer->endFrame();
+    fontRenderer->endFrame();
 
+    // Release the frame on schedule (sleeps/spins in capped mode) and record its interval
+    framePacer.pace();
 
+    // Late latch: the crosshair goes on top of the finished frame at the cursor position sampled
+    // right now, after any pacing wait, so it shows where a click would be scored at this moment
+    vec2 cursor = input->getLatestCursor();
+    crosshair->draw(vec2(cursor.x, height - cursor.y));
+    glfwSwapBuffers(window);
 }
 
 bool Engine::shouldClose() {
@@ -478,49 +326,6 @@ GLenum Engine::glCheckError_(const char *file, int line) {
     return errorCode;
 }
 
-int Engine::value(float item, string type) {
-    //a function to help find the value from the slider's position, by putting their positions into
-    //a linear function with a predefined range
-    //the ranges for the size, speed, target count, and time variables
-    int lowSize = 5;
-    int highSize = 105;
-
-    int lowSpeed = 1;
-    int highSpeed = 5;
-
-    int lowCount = 1;
-    int highCount = 6;
-
-    int lowTime = 15;
-    int highTime = 61;
-
-    //this turns the slider's literal width (say, 375) into a float with a decimal, to represent
-    //it's value out of 8, with the low bound of the slider being 1.8/8 and the high being 6.2/8
-    item = item/175;
-
-
-    if(type == "size") {
-        //the function for finding the size value
-        return 252/11 * (item - 1.8) + 5;
-    }
-    if(type == "speed") {
-        //the function for finding the speed value
-        return (0.92 * (item - 1.8) + 1);
-    }
-    if(type == "count") {
-        //the function for finding the count value
-        return 1.15 * (item - 1.8) + 1;
-    }
-
-    if(type == "time") {
-        //the function for finding the time value
-        return 10.5 * (item - 1.8) + 15;
-    }
-    else {
-        return 0;
-    }
-}
-
     void Engine::statsWindow() {
     //function to initialize the stats window
     //initializing a new window
@@ -1,17 +1,28 @@
 #ifndef GRAPHICS_ENGINE_H
 #define GRAPHICS_ENGINE_H
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <thread>
 #include <GLFW/glfw3.h>
 
 #include "shader/shaderManager.h"
+#include "shader/frameUniforms.h"
 #include "font/fontRenderer.h"
+#include "game/simulation.h"
+#include "input/inputSystem.h"
+#include "renderer/assetLoader.h"
+#include "renderer/crosshairRenderer.h"
+#include "renderer/renderQueue.h"
+#include "renderer/streamBuffer.h"
+#include "renderer/targetBatchRenderer.h"
 #include "shapes/rect.h"
 #include "shapes/shape.h"
 #include "shapes/cube.h"
 #include "shapes/circle.h"
+#include "util/framePacer.h"
 
 using std::vector, std::unique_ptr, std::make_unique, glm::ortho, glm::mat4, glm::vec3, glm::vec4;
 
@@ -31,58 +42,84 @@ private:
     const unsigned int width = 1400, height = 800; // Window dimensions
 
     const unsigned int newWidth = 400, newHeight = 400; // Window dimensions for second window
-    /// @brief The projection matrix
-    const glm::mat4 projection = glm::ortho(0.0f, (float)width, 0.0f, (float)height);
 
+    /// @brief Longest time the input pump sleeps between two polls (seconds), so it runs at 1000 Hz or faster.
+    const double inputPeriod = 0.001;
 
-    /// @brief Keyboard state (True if pressed, false if not pressed).
-    /// @details Index this array with GLFW_KEY_{key} to get the state of a key.
-    bool keys[1024];
+    /// @brief Draws frames while the main thread pumps input; owns the window's context while it runs.
+    std::thread renderThread;
+    std::atomic<bool> rendering{false};
+
+    /// @brief The render thread: makes the context current and renders until run() stops it.
+    void renderLoop();
+
+
+    /// @brief Keyboard and mouse state and the events of the frame, fed by GLFW callbacks.
+    /// @details Initialized right after the window; query it with GLFW_KEY_{key} / GLFW_MOUSE_BUTTON_{button}.
+    unique_ptr<InputSystem> input;
+
+    /// @brief Runs the game logic at a fixed tick on its own thread; render() draws its snapshots.
+    /// @details Initialized in the constructor, after the shapes; stopped first in ~Engine()
+    unique_ptr<Simulation> simulation;
+
+    /// @brief The snapshot before the one the simulation holds for us, to interpolate from
+    GameSnapshot previousSnapshot;
+
+    /// @brief Loads shaders and fonts on a background thread with a shared OpenGL context.
+    /// @details Initialized in initShaders(), destroyed first in ~Engine()
+    unique_ptr<AssetLoader> assetLoader;
+
+    /// @brief Limits the frame rate (vsync, uncapped or capped) and measures the frame intervals.
+    FramePacer framePacer;
+
+    /// @brief Seeds the simulation's random streams; the same seed spawns the same targets.
+    uint64_t seed;
+
+    /// @brief How the targets are shaded (disc, ring or outline), applied to the target renderer in initShaders().
+    TargetStyle targetStyle;
 
     /// @brief Responsible for loading and storing all the shaders used in the project.
     /// @details Initialized in initShaders()
     unique_ptr<ShaderManager> shaderManager;
 
+    /// @brief Ring buffer shared by all geometry that is rewritten every frame (text, target instances).
+    /// @details Initialized in initShaders(), fenced at the end of render()
+    unique_ptr<StreamBuffer> streamBuffer;
+
+    /// @brief Collects the draws of a frame and submits them sorted by state at the end of render().
+    /// @details Initialized in initShaders()
+    unique_ptr<RenderQueue> renderQueue;
+
+    /// @brief Draw calls issued and frames flushed over the session, reported on exit (render thread).
+    unsigned long drawCalls = 0, drawnFrames = 0;
+
     /// @brief Responsible for rendering text on the screen.
     /// @details Initialized in initShaders()
     unique_ptr<FontRenderer> fontRenderer;
 
+    /// @brief Draws all the confetti targets in a single instanced call.
+    /// @details Initialized in initShaders()
+    unique_ptr<TargetBatchRenderer> targetRenderer;
+
+    /// @brief Draws the crosshair that replaces the OS cursor, last thing before the swap.
+    /// @details Initialized in initShaders()
+    unique_ptr<CrosshairRenderer> crosshair;
+
+    /// @brief Per-frame uniform buffer (projection, view, time, viewport) shared by all shaders.
+    /// @details Initialized in initShaders(), updated once at the start of render()
+    unique_ptr<FrameUniforms> frameUniforms;
+
     //instances of buttons for the sliders. I needed spawnButton to declared for the base program to work
     unique_ptr<Shape> countButton;
     unique_ptr<Shape> timeButton;
     unique_ptr<Shape> speedButton;
     unique_ptr<Shape> spawnButton;
     unique_ptr<Shape> sizeButton;
-    vector<unique_ptr<Shape>> confetti;
-
-    //variables for the misses and accuracy of the user
-    int misses;
-    float accuracy;
-
-    //variable for the number of targets that the user has hit
-    int gotchaCount = 0;
-
-    // Shaders
-    Shader shapeShader;
-    Shader textShader;
 
-    //mouse variables
-    double MouseX, MouseY;
-    bool mousePressedLastFrame = false;
-
-    //the variables for keeping track of time, so that the user has unlimited time in the main menu,
-    //but limited time picking settings
-    float startTime = 0.0;
-    float lastSpawn = 0.0;
-    float settingsTime = 0.0;
-    float gameTime = 0.0;
-
-    //I hard coded these values in so that the game would be able to run without a user's modifying the sliders
-    //Though they change from user input (the sliders)
-    float finalSize = value(width/2, "size");
-    float finalSpeed = value(width/2, "speed");
-    int finalCount = value(width/2, "count");
-    int finalTime = value(width/2, "time");
+    // Shaders (entries of the shader manager, loaded asynchronously)
+    Shader* shapeShader = nullptr;
+    Shader* textShader = nullptr;
+    Shader* targetShader = nullptr;
 
     //Functions for helping the stats window close
     void statsWindow();
@@ -96,7 +133,12 @@ private:
 public:
     /// @brief Constructor for the Engine class.
     /// @details Initializes window and shaders.
-    Engine();
+    /// @param pacing How the frame rate is limited
+    /// @param fpsCap The frame rate cap (only used with PacingMode::Capped)
+    /// @param seed Seeds the game's random streams, for repeatable sessions
+    /// @param targetStyle How the targets are shaded
+    Engine(PacingMode pacing = PacingMode::VSync, double fpsCap = 0.0, uint64_t seed = 0,
+           TargetStyle targetStyle = TargetStyle::Disc);
 
     /// @brief Destructor for the Engine class.
     ~Engine();
@@ -112,29 +154,19 @@ public:
     /// @brief Initializes the shapes to be rendered.
     void initShapes();
 
-    /// @brief Pushes back a new colored rectangle to the confetti vector.
-    void spawnConfetti();
+    /// @brief Runs the game until the window is closed.
+    /// @details Hands the context to a render thread and pumps input on this (the main) thread, so
+    /// input is sampled at inputPeriod however long a frame takes. Takes the context back before returning.
+    void run();
 
     /// @brief Processes input from the user.
-    /// @details (e.g. keyboard input, mouse input, etc.)
+    /// @details Waits up to inputPeriod for the window's events and hands them to the simulation (escape closes the window here).
     void processInput();
 
-    /// @brief Updates the game state.
-    /// @details (e.g. collision detection, delta time, etc.)
-    void update();
-
     /// @brief Renders the game state.
-    /// @details Displays/renders objects on the screen.
+    /// @details Draws the newest simulation snapshot, interpolated from the one before it (render thread).
     void render();
 
-    //for converting from a certain button's range to a value
-    int value(float item, string type);
-
-
-    /* deltaTime variables */
-    float deltaTime = 0.0f; // Time between current frame and last frame
-    float lastFrame = 0.0f; // Time of last frame (used to calculate deltaTime)
-
     // -----------------------------------
     // Getters
     // -----------------------------------
@@ -0,0 +1,97 @@
+#include "atlasFile.h"
+#include "glyphCache.h"
+#include "glyphRasterizer.h"
+#include "skylinePacker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    constexpr char ATLAS_MAGIC[4] = {'G', 'A', 'T', 'L'};
+    constexpr uint32_t ATLAS_VERSION = 1;
+}
+
+AtlasView BakedAtlas::view() const {
+    return {&header, glyphs.data(), pixels.data()};
+}
+
+BakedAtlas bakeAtlas(const std::string &fontPath, unsigned int fontSize, uint64_t fontHash, int pageSize,
+                     const std::vector<char32_t> &codepoints) {
+    std::vector<GlyphSet> sets = {{fontPath, fontSize, codepoints, {}}};
+    rasterizeGlyphSets(sets);
+
+    BakedAtlas atlas{};
+    std::memcpy(atlas.header.magic, ATLAS_MAGIC, sizeof(ATLAS_MAGIC));
+    atlas.header.version = ATLAS_VERSION;
+    atlas.header.fontHash = fontHash;
+    atlas.header.fontSize = fontSize;
+    atlas.header.width = pageSize;
+    atlas.header.height = pageSize;
+    atlas.pixels.assign(pageSize * pageSize, 0);
+
+    // pack exactly the way the glyph cache does, so it can replay the packing when loading
+    SkylinePacker packer(pageSize, pageSize);
+    for (const GlyphBitmap &glyph: sets[0].glyphs) {
+        if (!glyph.Loaded)
+            continue;
+        glm::ivec2 origin(0);
+        bool empty = glyph.Size.x == 0 || glyph.Size.y == 0;
+        if (!empty && !packer.pack(glyph.Size.x + GlyphCache::PADDING, glyph.Size.y + GlyphCache::PADDING, origin))
+            continue;
+
+        for (int row = 0; row < glyph.Size.y; row++)
+            std::memcpy(&atlas.pixels[(origin.y + row) * pageSize + origin.x], &glyph.Pixels[row * glyph.Size.x], glyph.Size.x);
+        atlas.glyphs.push_back({
+            static_cast<uint32_t>(glyph.Codepoint),
+            static_cast<uint16_t>(origin.x), static_cast<uint16_t>(origin.y),
+            static_cast<uint16_t>(glyph.Size.x), static_cast<uint16_t>(glyph.Size.y),
+            static_cast<int16_t>(glyph.Bearing.x), static_cast<int16_t>(glyph.Bearing.y),
+            glyph.Advance
+        });
+    }
+    atlas.header.glyphCount = static_cast<uint32_t>(atlas.glyphs.size());
+    return atlas;
+}
+
+bool writeAtlasFile(const std::string &path, const BakedAtlas &atlas) {
+    // write to a temporary name and rename, so a crash never leaves a truncated atlas behind
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+        file.write(reinterpret_cast<const char *>(&atlas.header), sizeof(AtlasFileHeader));
+        file.write(reinterpret_cast<const char *>(atlas.glyphs.data()), atlas.glyphs.size() * sizeof(AtlasFileGlyph));
+        file.write(reinterpret_cast<const char *>(atlas.pixels.data()), atlas.pixels.size());
+        if (!file)
+            return false;
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool readAtlasFile(const MappedFile &file, uint64_t fontHash, unsigned int fontSize, int pageSize, AtlasView &view) {
+    if (!file.isOpen() || file.size() < sizeof(AtlasFileHeader))
+        return false;
+
+    const auto *header = reinterpret_cast<const AtlasFileHeader *>(file.data());
+    if (std::memcmp(header->magic, ATLAS_MAGIC, sizeof(ATLAS_MAGIC)) != 0 || header->version != ATLAS_VERSION ||
+        header->fontHash != fontHash || header->fontSize != fontSize ||
+        header->width != static_cast<uint32_t>(pageSize) || header->height != static_cast<uint32_t>(pageSize))
+        return false;
+
+    size_t glyphBytes = size_t(header->glyphCount) * sizeof(AtlasFileGlyph);
+    size_t pixelBytes = size_t(header->width) * header->height;
+    if (file.size() != sizeof(AtlasFileHeader) + glyphBytes + pixelBytes)
+        return false;
+
+    // the mapping is page aligned and the header is 32 bytes, so the glyph records are aligned too
+    view.header = header;
+    view.glyphs = reinterpret_cast<const AtlasFileGlyph *>(file.data() + sizeof(AtlasFileHeader));
+    view.pixels = file.data() + sizeof(AtlasFileHeader) + glyphBytes;
+    return true;
+}
+
+std::string atlasFilePath(const std::string &fontPath, unsigned int fontSize) {
+    return fontPath + "." + std::to_string(fontSize) + ".atlas";
+}
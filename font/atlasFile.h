@@ -0,0 +1,83 @@
+#ifndef GRAPHICS_ATLASFILE_H
+#define GRAPHICS_ATLASFILE_H
+
+#include "../util/mappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief First bytes of a prebaked atlas file
+ * @details The file is this header, glyphCount AtlasFileGlyph records, then width * height bytes of
+ * R8 pixels, all in native byte order. Glyphs are listed in the order they were packed, so replaying
+ * the same packing reproduces their origins (see GlyphCache::loadPage()).
+ */
+struct AtlasFileHeader {
+    char     magic[4];
+    uint32_t version;
+    /// @brief FNV-1a hash of the font file the atlas was baked from
+    uint64_t fontHash;
+    uint32_t fontSize;
+    uint32_t glyphCount;
+    uint32_t width, height;
+};
+
+/// @brief Metrics and atlas position of one baked glyph
+struct AtlasFileGlyph {
+    uint32_t codepoint;
+    uint16_t x, y, w, h;
+    int16_t  bearingX, bearingY;
+    /// @brief In 1/64 pixels, as FreeType reports it
+    uint32_t advance;
+};
+
+static_assert(sizeof(AtlasFileHeader) == 32, "atlas header layout changed");
+static_assert(sizeof(AtlasFileGlyph) == 20, "atlas glyph layout changed");
+
+/// @brief Read-only pointers into an atlas, either mapped from a file or freshly baked
+struct AtlasView {
+    const AtlasFileHeader *header;
+    const AtlasFileGlyph  *glyphs;
+    const unsigned char   *pixels;
+};
+
+/// @brief An atlas baked in memory, ready to be written out
+struct BakedAtlas {
+    AtlasFileHeader             header;
+    std::vector<AtlasFileGlyph> glyphs;
+    std::vector<unsigned char>  pixels;
+
+    /// @brief Points a view at this atlas
+    AtlasView view() const;
+};
+
+/**
+ * @brief Rasterizes glyphs (on worker threads) and packs them into one atlas page
+ * @details Glyphs that don't fit on the page are left out and get rasterized on demand later.
+ *
+ * @param fontPath The font file
+ * @param fontSize The size of the font
+ * @param fontHash The hash of the font file, stored in the header
+ * @param pageSize Width and height of the page, must match the glyph cache's
+ * @param codepoints The glyphs to bake
+ */
+BakedAtlas bakeAtlas(const std::string &fontPath, unsigned int fontSize, uint64_t fontHash, int pageSize,
+                     const std::vector<char32_t> &codepoints);
+
+/**
+ * @brief Writes a baked atlas to disk
+ * @return false if the file couldn't be written
+ */
+bool writeAtlasFile(const std::string &path, const BakedAtlas &atlas);
+
+/**
+ * @brief Validates a mapped atlas file and points a view into it
+ * @return false if the file is truncated, of another version, or baked from another font, size or page size
+ */
+bool readAtlasFile(const MappedFile &file, uint64_t fontHash, unsigned int fontSize, int pageSize, AtlasView &view);
+
+/// @brief Where the atlas of a font at a size is kept (next to the font file)
+std::string atlasFilePath(const std::string &fontPath, unsigned int fontSize);
+
+#endif //GRAPHICS_ATLASFILE_H
@@ -1,77 +1,90 @@
 #include "font.h"
-#include <glad/glad.h>
+#include "../util/hash.h"
+#include "../util/mappedFile.h"
 
 #include <iostream>
 
-Font::Font(std::string fontPath, unsigned int fontSize) {
-    FT_Library ft;
+Font::Font(std::string fontPath, unsigned int fontSize) : fontPath(fontPath), fontSize(fontSize) {
+    MappedFile fontFile(fontPath);
+    if (!fontFile.isOpen()) {
+        std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        return;
+    }
+    uint64_t fontHash = fnv1a(reinterpret_cast<const char *>(fontFile.data()), fontFile.size());
+
+    // warm start: map the prebaked atlas and upload it as it is, FreeType isn't touched
+    std::string atlasPath = atlasFilePath(fontPath, fontSize);
+    MappedFile atlasFile(atlasPath);
+    AtlasView view{};
+    if (readAtlasFile(atlasFile, fontHash, fontSize, cache.getPageSize(), view) && cache.loadPage(view))
+        return;
+
+    // first run, or the font changed: bake the printable ASCII set and keep it for next launch
+    std::vector<char32_t> codepoints;
+    for (char32_t c = 32; c < 127; c++)
+        codepoints.push_back(c);
+    BakedAtlas baked = bakeAtlas(fontPath, fontSize, fontHash, cache.getPageSize(), codepoints);
+    if (!writeAtlasFile(atlasPath, baked))
+        std::cout << "| WARNING::FONT: could not write atlas file " << atlasPath << std::endl;
+    cache.loadPage(baked.view());
+}
+
+Font::~Font() {
+    if (face)
+        FT_Done_Face(face);
+    if (ft)
+        FT_Done_FreeType(ft);
+}
+
+const Character *Font::getCharacter(char32_t codepoint) {
+    const Character *ch = cache.find(codepoint);
+    if (ch || !openFace())
+        return ch;
+
+    // first use: load character glyph (index 0, the missing-glyph box, if the font lacks it)
+    GlyphBitmap glyph;
+    if (!rasterizeGlyph(face, codepoint, glyph))
+        return nullptr;
+    return upload(glyph);
+}
+
+void Font::touchPage(unsigned int texture) {
+    cache.touchPage(texture);
+}
+
+void Font::endFrame() {
+    cache.endFrame();
+}
+
+unsigned long Font::getGeneration() const {
+    return cache.getGeneration();
+}
+
+bool Font::openFace() {
+    if (face || faceFailed)
+        return face != nullptr;
+    faceFailed = true;
 
     // Initialize FreeType library
     if (FT_Init_FreeType(&ft)) {
         std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        ft = nullptr;
+        return false;
     }
 
     // Load font as face
-    FT_Face face;
     if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        face = nullptr;
+        return false;
     }
 
     // Set size to load glyphs as
     FT_Set_Pixel_Sizes(face, 0, fontSize);
-
-    // Attempt to load character glyph
-    if (FT_Load_Char(face, 'X', FT_LOAD_RENDER)) {
-        std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
-    }
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
-
-    // Load first 128 characters of ASCII set
-    for (unsigned char c = 0; c < 128; c++) {
-        // load character glyph 
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-            std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
-            continue;
-        }
-
-        // generate texture
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-
-        // set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<unsigned int>(face->glyph->advance.x)
-        };
-        Characters.insert(std::pair<char, Character>(c, character));
-    }
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    faceFailed = false;
+    return true;
 }
 
-std::map<char, Character> Font::getCharacters() const {
-    return Characters;
+const Character *Font::upload(const GlyphBitmap &glyph) {
+    return cache.insert(glyph.Codepoint, glyph.Size, glyph.Pixels.data(), glyph.Size.x, glyph.Bearing, glyph.Advance);
 }
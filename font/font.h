@@ -1,59 +1,108 @@
 #ifndef GRAPHICS_FONT_H
 #define GRAPHICS_FONT_H
 
-#include <map>
 #include <string>
+#include <vector>
 
+#include "glyphCache.h"
+#include "glyphRasterizer.h"
 
 #include <glm/glm.hpp>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
-/**
- * @brief A single character
- * @details This struct is used to store information about a single character
- * 
- * @param TextureID ID handle of the glyph texture
- * @param Size Size of glyph
- * @param Bearing Offset from baseline to left/top of glyph
- * @param Advance Offset to advance to next glyph
- */
-struct Character {
-    unsigned int TextureID;
-    glm::ivec2   Size;
-    glm::ivec2   Bearing;
-    unsigned int Advance;
-};
-
 /**
  * @brief A font
- * @details This class is used to store information about a font
+ * @details This class is used to store information about a font. Glyphs are kept in a GlyphCache
+ * of atlas pages. The printable ASCII set is baked once into an atlas file next to the font
+ * (see atlasFile.h); later launches map that file and upload it directly. Any other glyph is
+ * rasterized the first time it is asked for, and FreeType is only initialized at that point.
  */
 class Font {
     public:
         /**
          * @brief Construct a new Font object
+         * @details Loads the baked atlas, baking and writing it first if it is missing or stale
          * 
          * @param fontPath The path to the font file
          * @param fontSize The size of the font
          */
         Font(std::string fontPath, unsigned int fontSize);
 
-        
         /**
-         * @brief Get the characters
-         * 
-         * @return a map of characters
+         * @brief Destroy the Font object
+         * @details Closes the font file (the atlas pages are deleted by the glyph cache)
+         */
+        ~Font();
+
+        Font(const Font&) = delete;
+        Font& operator=(const Font&) = delete;
+
+        /**
+         * @brief Get a character, rasterizing it on first use
+         * @details Codepoints the font has no glyph for get the font's missing-glyph box.
+         * The returned pointer is only valid until the next call, which may evict it.
+         *
+         * @param codepoint The Unicode codepoint
+         * @return the character, or nullptr if it could not be rasterized
+         */
+        const Character* getCharacter(char32_t codepoint);
+
+        /**
+         * @brief Keeps an atlas page from being evicted this frame
+         * @details Call for every page a cached layout draws from
+         *
+         * @param texture The atlas page texture
+         */
+        void touchPage(unsigned int texture);
+
+        /**
+         * @brief Marks the end of a frame for the glyph cache's LRU order
+         */
+        void endFrame();
+
+        /**
+         * @brief Get the glyph cache generation
+         *
+         * @return a counter that changes whenever glyphs are evicted and previously returned UVs may be stale
          */
-        std::map<char, Character> getCharacters() const;
+        unsigned long getGeneration() const;
 
     private:
         /**
-         * @brief A set of character structs mapped to their ASCII character representations
+         * @brief The font file and the pixel size glyphs are rasterized at
+         */
+        std::string fontPath;
+        unsigned int fontSize;
+
+        /**
+         * @brief The FreeType library and the face of the font file, opened by openFace()
+         */
+        FT_Library ft = nullptr;
+        FT_Face face = nullptr;
+
+        /**
+         * @brief Set if opening the face failed, so it isn't retried for every glyph
          */
-        std::map<char, Character> Characters;
+        bool faceFailed = false;
 
+        /**
+         * @brief The glyphs rasterized so far
+         */
+        GlyphCache cache;
+
+        /**
+         * @brief Initializes FreeType and opens the face on first use
+         *
+         * @return false if the face couldn't be opened
+         */
+        bool openFace();
+
+        /**
+         * @brief Packs a rasterized glyph into the cache
+         */
+        const Character* upload(const GlyphBitmap &glyph);
 };
 
 #endif //GRAPHICS_FONT_H
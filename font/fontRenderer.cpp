@@ -1,74 +1,172 @@
 #include "fontRenderer.h"
+#include "../util/utf8.h"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <vector>
 
-FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize) {
-    this->shader = shader;
+FontRenderer::FontRenderer(Shader& shader, StreamBuffer& stream, RenderQueue& queue, AssetLoader* loader, std::string fontPath, int fontSize)
+        : shader(shader), stream(stream), queue(queue) {
     this->initRenderData();
-    Font myFont(fontPath, fontSize);
-    this->font = myFont.getCharacters();
+
+    // file mapping, baking and the atlas upload all happen on the loader thread
+    auto promise = std::make_shared<std::promise<std::unique_ptr<Font>>>();
+    pendingFont = promise->get_future();
+    auto load = [promise, fontPath, fontSize] {
+        auto loaded = std::make_unique<Font>(fontPath, fontSize);
+        // the atlas is sampled from the main context, so it has to be complete before it is published
+        glFinish();
+        promise->set_value(std::move(loaded));
+        return true;
+    };
+    if (loader)
+        loader->enqueue(load);
+    else
+        load();
+}
+
+bool FontRenderer::isReady() {
+    if (!font && pendingFont.valid() && pendingFont.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        font = pendingFont.get();
+    return font != nullptr;
 }
 
 FontRenderer::~FontRenderer() {
     glDeleteVertexArrays(1, &this->VAO);
-    glDeleteBuffers(1, &this->VBO);
 }
 
 void FontRenderer::initRenderData() {
+    // glyph quads are written into the shared stream buffer, so the VAO only describes the layout
     glGenVertexArrays(1, &this->VAO);
-    glGenBuffers(1, &this->VBO);
     glBindVertexArray(this->VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+    setVertexLayout();
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void FontRenderer::renderText(std::string text, float x, float y, const glm::mat4 projection, float scale, glm::vec3 color) {
-    // activate corresponding render state
+void FontRenderer::setVertexLayout() {
+    // <vec2 pos, vec2 tex>
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, x));
+    // packed RGBA8 color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextVertex), (void*)offsetof(TextVertex, color));
+}
 
-    this->shader.use();
-    glUniformMatrix4fv(glGetUniformLocation(this->shader.ID, "projection"), 1, false, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(this->shader.ID, "textColor"), color.x, color.y, color.z);
+void FontRenderer::renderText(std::string text, float x, float y, float scale, glm::vec3 color) {
+    if (!isReady())
+        return;
+    layoutText(text, x, y, scale, packColor(color));
+    if (vertices.empty())
+        return;
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(this->VAO);
+    // copy the quads of the whole string straight into the stream buffer
+    StreamBuffer::Allocation block = stream.allocate(vertices.size() * sizeof(TextVertex), sizeof(TextVertex));
+    if (!block.data)
+        return;
+    std::memcpy(block.data, vertices.data(), vertices.size() * sizeof(TextVertex));
+    stream.flush();
 
-    // iterate through all characters
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        Character ch = font[*c];
-
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
-        // update VBO for each character
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 0.0f },            
-            { xpos,     ypos,       0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-
-            { xpos,     ypos + h,   0.0f, 0.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-            { xpos + w, ypos + h,   1.0f, 0.0f }           
-        };
-        // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-        // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
+    submitRuns(this->VAO, static_cast<int>(block.offset / sizeof(TextVertex)), runs);
+}
+
+void FontRenderer::renderStaticText(std::string text, float x, float y, float scale, glm::vec3 color) {
+    if (!isReady())
+        return;
+    unsigned int packed = packColor(color);
+    TextLayoutCache::Layout *layout = cache.find(text, x, y, scale, packed);
+    if (layout && layout->generation != font->getGeneration())
+        layout = nullptr; // glyphs were evicted since it was built, its UVs may point at other glyphs
+
+    if (layout) {
+        // nothing is looked up, so keep the pages it samples from being recycled this frame
+        for (const TextRun &run: layout->runs)
+            font->touchPage(run.texture);
+    }
+    else {
+        layoutText(text, x, y, scale, packed);
+        if (vertices.empty())
+            return;
+
+        // first time this exact text is drawn: lay it out once into its own static buffer
+        layout = &cache.insert(text, x, y, scale, packed);
+        layout->runs = runs;
+        layout->generation = font->getGeneration();
+        glBindVertexArray(layout->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, layout->VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TextVertex), vertices.data(), GL_STATIC_DRAW);
+        setVertexLayout();
         glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        glBindVertexArray(0);
+    }
+
+    submitRuns(layout->VAO, 0, layout->runs);
+}
+
+void FontRenderer::endFrame() {
+    cache.endFrame();
+    if (font)
+        font->endFrame();
+}
+
+void FontRenderer::submitRuns(GLuint VAO, int base, const std::vector<TextRun> &textRuns) {
+    for (const TextRun &run: textRuns) {
+        RenderCommand command;
+        command.layer = RenderLayer::Text;
+        command.shader = &this->shader;
+        command.texture = run.texture;
+        command.VAO = VAO;
+        command.first = base + run.first;
+        command.count = run.count;
+        queue.submit(command);
+    }
+}
+
+void FontRenderer::layoutText(const std::string &text, float x, float y, float scale, unsigned int color) {
+    vertices.clear();
+    runs.clear();
+
+    // iterate through all codepoints
+    for (size_t i = 0; i < text.size();) {
+        const Character *found = font->getCharacter(nextCodepoint(text, i));
+        if (!found)
+            continue;
+        const Character &ch = *found;
+
+        if (ch.Size.x > 0 && ch.Size.y > 0) {
+            float xpos = x + ch.Bearing.x * scale;
+            float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+            float w = ch.Size.x * scale;
+            float h = ch.Size.y * scale;
+            float u0 = ch.UV.x, v0 = ch.UV.y, u1 = ch.UV.z, v1 = ch.UV.w;
+
+            // consecutive glyphs on the same atlas page share a run
+            if (runs.empty() || runs.back().texture != ch.Texture)
+                runs.push_back({ch.Texture, static_cast<int>(vertices.size()), 0});
+            runs.back().count += 6;
+
+            // two triangles per glyph, textured from the glyph's rectangle in its atlas page
+            vertices.insert(vertices.end(), {
+                { xpos,     ypos + h,   u0, v0, color },
+                { xpos,     ypos,       u0, v1, color },
+                { xpos + w, ypos,       u1, v1, color },
+
+                { xpos,     ypos + h,   u0, v0, color },
+                { xpos + w, ypos,       u1, v1, color },
+                { xpos + w, ypos + h,   u1, v0, color }
+            });
+        }
         // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
         x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
     }
+}
 
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+unsigned int FontRenderer::packColor(const glm::vec3 &color) {
+    auto channel = [](float v) { return static_cast<unsigned int>(glm::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(color.x) | channel(color.y) << 8 | channel(color.z) << 16 | 255u << 24;
 }
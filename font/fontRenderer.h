@@ -4,6 +4,14 @@
 #include "../shader/shaderManager.h"
 #include "../shader/shader.h"
 #include "font.h"
+#include "textLayoutCache.h"
+#include "../renderer/streamBuffer.h"
+#include "../renderer/renderQueue.h"
+#include "../renderer/assetLoader.h"
+
+#include <future>
+#include <memory>
+#include <vector>
 
 /**
  * @brief A font renderer
@@ -13,53 +21,144 @@ class FontRenderer {
     public:
         /**
          * @brief Construct a new Font Renderer object
-         * @details This constructor will call the font constructor and initialize the render data
+         * @details This constructor will initialize the render data and start loading the font on the
+         * asset loader; text drawn before the font is ready is skipped (see isReady())
          * 
-         * @param shader The shader to use
+         * @param shader The shader to use (may still be loading, draws wait for it)
+         * @param stream The stream buffer glyph quads are written to
+         * @param queue The render queue glyph draws are recorded into
+         * @param loader Loads the font in the background (nullptr to load it right here)
          * @param fontPath The path to the font file
          * @param fontSize The size of the font
          */
-        FontRenderer(Shader& shader, std::string fontPath, int fontSize);
+        FontRenderer(Shader& shader, StreamBuffer& stream, RenderQueue& queue, AssetLoader* loader, std::string fontPath, int fontSize);
 
         /**
          * @brief Destroy the Font Renderer object
-         * @details destroys the VAO and VBO associated with the font renderer
+         * @details destroys the VAO associated with the font renderer (the font deletes its atlas pages)
          */
         ~FontRenderer();
 
         /**
          * @brief Renders text on the screen
+         * @details The text is decoded as UTF-8. Builds the quads of the whole string into the stream buffer
+         * and records them into the render queue (text layer), one draw per atlas page the string uses.
+         * Strings carry their color per vertex, so the queue merges every string of the frame that samples
+         * the same page into a single draw call.
          * 
          * @param text The text to render
          * @param x The x position of the text
          * @param y The y position of the text
-         * @param projection The projection matrix
          * @param scale The scale of the text
          * @param color The color of the text
          */
-        void renderText(std::string text, float x, float y, const glm::mat4 projection, float scale, glm::vec3 color);
+        void renderText(std::string text, float x, float y, float scale, glm::vec3 color);
+
+        /**
+         * @brief Renders text that is drawn the same way every frame
+         * @details Same as renderText(), but the layout is built once and kept on the GPU in the layout
+         * cache; later frames redraw it with one call. Use renderText() for text that changes every
+         * frame (countdowns, scores), since every distinct string/position gets its own cache entry.
+         * The layout is rebuilt if glyphs it uses were evicted from the atlas.
+         *
+         * @param text The text to render
+         * @param x The x position of the text
+         * @param y The y position of the text
+         * @param scale The scale of the text
+         * @param color The color of the text
+         */
+        void renderStaticText(std::string text, float x, float y, float scale, glm::vec3 color);
+
+        /**
+         * @brief True once the font has finished loading
+         */
+        bool isReady();
+
+        /**
+         * @brief Evicts cached layouts that have not been drawn for a while and ages the glyph cache
+         * @details Call once per frame.
+         */
+        void endFrame();
 
     private:
         /**
-         * @brief The shader to use
+         * @brief The shader to use (the ShaderManager's entry, so it becomes ready in place)
+         */
+        Shader& shader;
+
+        /**
+         * @brief The VAO associated with the font renderer
          */
-        Shader shader;
+        GLuint VAO;
 
         /**
-         * @brief The VAO and VBO associated with the font renderer
+         * @brief Ring buffer the glyph quads are streamed through (shared with other dynamic geometry)
          */
-        GLuint VAO, VBO;
+        StreamBuffer& stream;
 
         /**
-         * @brief A set of character structs mapped to their ASCII character representations
-         * @details This is the same map generated by the font class
+         * @brief Queue the glyph draws are recorded into
          */
-        std::map<char, Character> font;
+        RenderQueue& queue;
+
+        /**
+         * @brief The font, rasterizing glyphs into its atlas pages on demand (nullptr while loading)
+         */
+        std::unique_ptr<Font> font;
+
+        /**
+         * @brief The font being loaded on the asset loader, taken over by isReady()
+         */
+        std::future<std::unique_ptr<Font>> pendingFont;
+
+        /**
+         * @brief One corner of a glyph quad as the text shader reads it
+         * @details color is packed as RGBA8 and normalized to [0, 1] by the vertex fetch
+         */
+        struct TextVertex {
+            float x, y, u, v;
+            unsigned int color;
+        };
+
+        /**
+         * @brief GPU-resident layouts of the text drawn with renderStaticText()
+         */
+        TextLayoutCache cache;
+
+        /**
+         * @brief Vertices and page runs of the last layoutText() call, kept to reuse their storage
+         */
+        std::vector<TextVertex> vertices;
+        std::vector<TextRun> runs;
 
         /**
          * @brief Initializes and configures the buffer and vertex attributes
          */
         void initRenderData();
+
+        /**
+         * @brief Sets the TextVertex attribute layout on the bound VAO for the bound array buffer
+         */
+        void setVertexLayout();
+
+        /**
+         * @brief Lays out 6 vertices per visible glyph of the UTF-8 text into vertices, split into runs by atlas page
+         * @details Rasterizes glyphs that are not cached yet
+         */
+        void layoutText(const std::string &text, float x, float y, float scale, unsigned int color);
+
+        /**
+         * @brief Records one draw per run
+         *
+         * @param VAO The VAO the vertices are read through
+         * @param base Index of the first vertex of the text in the VAO's buffer
+         */
+        void submitRuns(GLuint VAO, int base, const std::vector<TextRun> &textRuns);
+
+        /**
+         * @brief Packs a color into RGBA8 (red in the lowest byte, opaque)
+         */
+        static unsigned int packColor(const glm::vec3 &color);
 };
 
 #endif // FONTRENDERER_H
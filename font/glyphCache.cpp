@@ -0,0 +1,186 @@
+#include "glyphCache.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+GlyphCache::GlyphCache(int pageSize, size_t maxPages) : pageSize(pageSize), maxPages(maxPages) {}
+
+GlyphCache::~GlyphCache() {
+    for (const Page &page: pages)
+        glDeleteTextures(1, &page.texture);
+}
+
+const Character *GlyphCache::find(char32_t codepoint) {
+    Entry *entry;
+    if (codepoint < ascii.size()) {
+        entry = ascii[codepoint];
+    }
+    else {
+        auto found = glyphs.find(codepoint);
+        entry = found == glyphs.end() ? nullptr : &found->second;
+    }
+    if (!entry)
+        return nullptr;
+    touch(*entry);
+    return &entry->character;
+}
+
+const Character *GlyphCache::insert(char32_t codepoint, glm::ivec2 size, const unsigned char *pixels, int pitch,
+                                    glm::ivec2 bearing, unsigned int advance) {
+    Entry entry{{glm::vec4(0.0f), size, bearing, advance, 0}, NO_PAGE};
+
+    // spaces and other empty glyphs only advance the cursor, they take no atlas space
+    if (size.x > 0 && size.y > 0) {
+        glm::ivec2 origin;
+        entry.page = reserve(size.x + PADDING, size.y + PADDING, origin);
+        Page &page = pages[entry.page];
+        page.codepoints.push_back(codepoint);
+
+        glBindTexture(GL_TEXTURE_2D, page.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, origin.x, origin.y, std::min(size.x, pageSize), std::min(size.y, pageSize),
+                        GL_RED, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        entry.character.Texture = page.texture;
+        entry.character.UV = glm::vec4(origin.x, origin.y, origin.x + size.x, origin.y + size.y) / float(pageSize);
+    }
+
+    Entry &stored = glyphs[codepoint] = entry;
+    if (codepoint < ascii.size())
+        ascii[codepoint] = &stored;
+    touch(stored);
+    return &stored.character;
+}
+
+void GlyphCache::touchPage(unsigned int texture) {
+    for (Page &page: pages) {
+        if (page.texture == texture)
+            page.lastUsed = frame;
+    }
+}
+
+bool GlyphCache::loadPage(const AtlasView &atlas) {
+    if (atlas.header->width != static_cast<uint32_t>(pageSize) || atlas.header->height != static_cast<uint32_t>(pageSize))
+        return false;
+
+    // replay the packing before touching anything, so a mismatching file leaves the cache as it was
+    SkylinePacker packer(pageSize, pageSize);
+    for (uint32_t i = 0; i < atlas.header->glyphCount; i++) {
+        const AtlasFileGlyph &glyph = atlas.glyphs[i];
+        if (glyph.w == 0 || glyph.h == 0)
+            continue;
+        glm::ivec2 origin;
+        if (!packer.pack(glyph.w + PADDING, glyph.h + PADDING, origin) || origin.x != glyph.x || origin.y != glyph.y)
+            return false;
+    }
+
+    addPage(atlas.pixels);
+    size_t index = pages.size() - 1;
+    Page &page = pages[index];
+    page.packer = packer;
+    for (uint32_t i = 0; i < atlas.header->glyphCount; i++) {
+        const AtlasFileGlyph &glyph = atlas.glyphs[i];
+        char32_t codepoint = glyph.codepoint;
+        Entry entry{{glm::vec4(0.0f), glm::ivec2(glyph.w, glyph.h), glm::ivec2(glyph.bearingX, glyph.bearingY), glyph.advance, 0}, NO_PAGE};
+        if (glyph.w > 0 && glyph.h > 0) {
+            entry.page = index;
+            entry.character.Texture = page.texture;
+            entry.character.UV = glm::vec4(glyph.x, glyph.y, glyph.x + glyph.w, glyph.y + glyph.h) / float(pageSize);
+            page.codepoints.push_back(codepoint);
+        }
+        Entry &stored = glyphs[codepoint] = entry;
+        if (codepoint < ascii.size())
+            ascii[codepoint] = &stored;
+    }
+    return true;
+}
+
+int GlyphCache::getPageSize() const {
+    return pageSize;
+}
+
+void GlyphCache::endFrame() {
+    frame++;
+}
+
+unsigned long GlyphCache::getGeneration() const {
+    return generation;
+}
+
+size_t GlyphCache::reserve(int w, int h, glm::ivec2 &origin) {
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (pages[i].packer.pack(w, h, origin))
+            return i;
+    }
+
+    // every page is full: recycle the least recently used one, unless it is still needed this frame
+    size_t oldest = NO_PAGE;
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (pages[i].lastUsed != frame && (oldest == NO_PAGE || pages[i].lastUsed < pages[oldest].lastUsed))
+            oldest = i;
+    }
+    size_t index;
+    if (pages.size() < maxPages || oldest == NO_PAGE) {
+        addPage();
+        index = pages.size() - 1;
+    }
+    else {
+        evict(oldest);
+        index = oldest;
+    }
+
+    // a glyph bigger than a whole page is clipped into an empty page rather than failing
+    if (!pages[index].packer.pack(w, h, origin))
+        origin = glm::ivec2(0);
+    return index;
+}
+
+void GlyphCache::addPage(const unsigned char *pixels) {
+    unsigned int texture;
+    std::vector<unsigned char> blank;
+    if (!pixels) {
+        blank.assign(pageSize * pageSize, 0);
+        pixels = blank.data();
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, pageSize, pageSize, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+
+    // set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    pages.push_back({texture, SkylinePacker(pageSize, pageSize), frame, {}});
+}
+
+void GlyphCache::evict(size_t index) {
+    Page &page = pages[index];
+    for (char32_t codepoint: page.codepoints) {
+        glyphs.erase(codepoint);
+        if (codepoint < ascii.size())
+            ascii[codepoint] = nullptr;
+    }
+    page.codepoints.clear();
+    page.packer.reset();
+
+    // clear the old pixels so the padding around new glyphs is empty again
+    std::vector<unsigned char> blank(pageSize * pageSize, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pageSize, pageSize, GL_RED, GL_UNSIGNED_BYTE, blank.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    generation++;
+}
+
+void GlyphCache::touch(const Entry &entry) {
+    if (entry.page != NO_PAGE)
+        pages[entry.page].lastUsed = frame;
+}
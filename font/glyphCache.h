@@ -0,0 +1,160 @@
+#ifndef GRAPHICS_GLYPHCACHE_H
+#define GRAPHICS_GLYPHCACHE_H
+
+#include "skylinePacker.h"
+#include "atlasFile.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief A single character
+ * @details This struct is used to store information about a single character
+ *
+ * @param UV Rectangle of the glyph in its atlas page (left, top, right, bottom, normalized)
+ * @param Size Size of glyph
+ * @param Bearing Offset from baseline to left/top of glyph
+ * @param Advance Offset to advance to next glyph
+ * @param Texture The atlas page texture holding the glyph (0 for glyphs without pixels)
+ */
+struct Character {
+    glm::vec4    UV;
+    glm::ivec2   Size;
+    glm::ivec2   Bearing;
+    unsigned int Advance;
+    unsigned int Texture;
+};
+
+/**
+ * @brief Rasterized glyphs, packed into single-channel atlas page textures as they are first needed
+ * @details Each page is packed with a SkylinePacker. When no page has room for a new glyph, another
+ * page is created up to maxPages; after that the least recently used page is emptied and its glyphs
+ * are dropped (a skyline can't free single rectangles, so glyphs are evicted a page at a time).
+ * A page drawn from in the current frame is never evicted, since quads already built this frame
+ * still point into it; if every page is in use the cache grows past maxPages instead.
+ *
+ * Every eviction bumps getGeneration(), so anything that stored UVs (cached text layouts) can tell
+ * it has to be rebuilt.
+ */
+class GlyphCache {
+    public:
+        /// @brief Space kept right of and below each glyph so linear filtering doesn't bleed
+        static constexpr int PADDING = 1;
+
+        /**
+         * @brief Construct a new Glyph Cache object
+         * @details No page is allocated until the first glyph is inserted
+         *
+         * @param pageSize Width and height of each atlas page in pixels
+         * @param maxPages Number of pages kept before the least recently used one is recycled
+         */
+        GlyphCache(int pageSize = 512, size_t maxPages = 4);
+
+        /**
+         * @brief Destroy the Glyph Cache object
+         * @details Deletes every page texture
+         */
+        ~GlyphCache();
+
+        GlyphCache(const GlyphCache&) = delete;
+        GlyphCache& operator=(const GlyphCache&) = delete;
+
+        /**
+         * @brief Looks up a glyph and marks its page used this frame
+         *
+         * @param codepoint The Unicode codepoint
+         * @return The glyph, or nullptr if it hasn't been inserted (or was evicted)
+         */
+        const Character* find(char32_t codepoint);
+
+        /**
+         * @brief Packs a rasterized glyph into a page and uploads its pixels
+         *
+         * @param codepoint The Unicode codepoint
+         * @param size Width and height of the bitmap
+         * @param pixels Rows of the 8-bit coverage bitmap
+         * @param pitch Bytes from one row to the next
+         * @param bearing Offset from baseline to left/top of glyph
+         * @param advance Offset to advance to next glyph, in 1/64 pixels
+         * @return The cached glyph, marked used this frame
+         */
+        const Character* insert(char32_t codepoint, glm::ivec2 size, const unsigned char *pixels, int pitch,
+                                glm::ivec2 bearing, unsigned int advance);
+
+        /**
+         * @brief Marks a page used this frame without looking up a glyph
+         * @details For draws that reuse UVs built in an earlier frame (cached layouts)
+         *
+         * @param texture The page texture
+         */
+        void touchPage(unsigned int texture);
+
+        /**
+         * @brief Adds a page from a prebaked atlas, uploading its pixels as they are
+         * @details The baked glyphs are packed again in file order, which reproduces their origins
+         * and leaves the page's free space usable for later glyphs.
+         *
+         * @param atlas The atlas, baked with this cache's page size
+         * @return false (and nothing added) if the packing doesn't match the file
+         */
+        bool loadPage(const AtlasView &atlas);
+
+        /// @brief Width and height of each atlas page in pixels
+        int getPageSize() const;
+
+        /// @brief Advances the frame counter that drives the LRU order
+        void endFrame();
+
+        /// @brief Increases every time glyphs are evicted
+        unsigned long getGeneration() const;
+
+    private:
+        /// @brief An atlas page texture and its packing state
+        struct Page {
+            unsigned int texture;
+            SkylinePacker packer;
+            /// @brief Frame a glyph on this page was last looked up or inserted
+            unsigned long lastUsed;
+            /// @brief Codepoints packed into this page
+            std::vector<char32_t> codepoints;
+        };
+
+        /// @brief A cached glyph and the page it lives on
+        struct Entry {
+            Character character;
+            /// @brief Index into pages, or NO_PAGE for glyphs without pixels
+            size_t page;
+        };
+
+        static constexpr size_t NO_PAGE = static_cast<size_t>(-1);
+
+        int pageSize;
+        size_t maxPages;
+        std::vector<Page> pages;
+
+        /// @brief Every cached glyph (unordered_map keeps element addresses stable on rehash)
+        std::unordered_map<char32_t, Entry> glyphs;
+
+        /// @brief Direct lookup for ASCII, the common case (nullptr if not cached)
+        std::array<Entry*, 128> ascii{};
+
+        unsigned long frame = 0;
+        unsigned long generation = 0;
+
+        /// @brief Finds room for a w*h rectangle, adding or recycling a page if needed
+        /// @return Index of the page the rectangle was packed into
+        size_t reserve(int w, int h, glm::ivec2 &origin);
+
+        /// @brief Creates a page texture from pixels (an empty page if nullptr)
+        void addPage(const unsigned char *pixels = nullptr);
+
+        /// @brief Drops every glyph on a page and empties its packer
+        void evict(size_t index);
+
+        /// @brief Marks an entry's page as used this frame
+        void touch(const Entry &entry);
+};
+
+#endif //GRAPHICS_GLYPHCACHE_H
@@ -0,0 +1,111 @@
+#include "glyphRasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <thread>
+
+namespace {
+    /// @brief A contiguous range of one set's codepoints, the unit of work of a worker
+    struct Chunk {
+        size_t set, begin, end;
+    };
+
+    /// @brief Fewer glyphs than this per chunk cost more in scheduling than they save
+    constexpr size_t MIN_CHUNK = 8;
+
+    void rasterizeChunks(std::vector<GlyphSet> &sets, const std::vector<Chunk> &chunks, std::atomic<size_t> &next) {
+        // FreeType objects are per thread: one library, one face per set this worker touches
+        FT_Library ft;
+        if (FT_Init_FreeType(&ft)) {
+            std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+            return;
+        }
+        std::map<size_t, FT_Face> faces;
+
+        for (size_t index = next++; index < chunks.size(); index = next++) {
+            const Chunk &chunk = chunks[index];
+            GlyphSet &set = sets[chunk.set];
+
+            auto found = faces.find(chunk.set);
+            if (found == faces.end()) {
+                FT_Face face = nullptr;
+                if (FT_New_Face(ft, set.fontPath.c_str(), 0, &face)) {
+                    std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+                    face = nullptr;
+                }
+                else {
+                    FT_Set_Pixel_Sizes(face, 0, set.fontSize);
+                }
+                found = faces.emplace(chunk.set, face).first;
+            }
+            if (!found->second)
+                continue;
+
+            // every chunk owns its slice of glyphs, so workers never write the same element
+            for (size_t i = chunk.begin; i < chunk.end; i++)
+                rasterizeGlyph(found->second, set.codepoints[i], set.glyphs[i]);
+        }
+
+        for (auto &iter: faces) {
+            if (iter.second)
+                FT_Done_Face(iter.second);
+        }
+        FT_Done_FreeType(ft);
+    }
+}
+
+bool rasterizeGlyph(FT_Face face, char32_t codepoint, GlyphBitmap &glyph) {
+    glyph.Codepoint = codepoint;
+    glyph.Loaded = false;
+    if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER)) {
+        std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
+        return false;
+    }
+
+    FT_GlyphSlot slot = face->glyph;
+    int w = slot->bitmap.width, h = slot->bitmap.rows;
+    glyph.Size = glm::ivec2(w, h);
+    glyph.Bearing = glm::ivec2(slot->bitmap_left, slot->bitmap_top);
+    glyph.Advance = static_cast<unsigned int>(slot->advance.x);
+
+    // copy the rows out, the glyph slot is reused by the next FT_Load_Char
+    glyph.Pixels.resize(w * h);
+    for (int row = 0; row < h; row++)
+        std::memcpy(&glyph.Pixels[row * w], slot->bitmap.buffer + row * slot->bitmap.pitch, w);
+    glyph.Loaded = true;
+    return true;
+}
+
+void rasterizeGlyphSets(std::vector<GlyphSet> &sets, unsigned int threadCount) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    // about one chunk per worker for the whole workload, so sets of any size spread evenly
+    size_t total = 0;
+    for (GlyphSet &set: sets) {
+        set.glyphs.assign(set.codepoints.size(), GlyphBitmap());
+        total += set.codepoints.size();
+    }
+    size_t chunkSize = std::max(MIN_CHUNK, (total + threadCount - 1) / threadCount);
+
+    std::vector<Chunk> chunks;
+    for (size_t s = 0; s < sets.size(); s++) {
+        for (size_t begin = 0; begin < sets[s].codepoints.size(); begin += chunkSize)
+            chunks.push_back({s, begin, std::min(begin + chunkSize, sets[s].codepoints.size())});
+    }
+    if (chunks.empty())
+        return;
+
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    unsigned int workerCount = static_cast<unsigned int>(std::min<size_t>(threadCount, chunks.size()));
+    for (unsigned int i = 1; i < workerCount; i++)
+        workers.emplace_back(rasterizeChunks, std::ref(sets), std::cref(chunks), std::ref(next));
+    // the calling thread works too instead of just waiting
+    rasterizeChunks(sets, chunks, next);
+    for (std::thread &worker: workers)
+        worker.join();
+}
@@ -0,0 +1,63 @@
+#ifndef GRAPHICS_GLYPHRASTERIZER_H
+#define GRAPHICS_GLYPHRASTERIZER_H
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+/**
+ * @brief A glyph rasterized on the CPU, not uploaded yet
+ *
+ * @param Codepoint The Unicode codepoint
+ * @param Size Size of glyph
+ * @param Bearing Offset from baseline to left/top of glyph
+ * @param Advance Offset to advance to next glyph
+ * @param Pixels Tightly packed rows of 8-bit coverage (Size.x * Size.y bytes)
+ * @param Loaded False if FreeType failed to render the glyph
+ */
+struct GlyphBitmap {
+    char32_t                   Codepoint = 0;
+    glm::ivec2                 Size{0};
+    glm::ivec2                 Bearing{0};
+    unsigned int               Advance = 0;
+    std::vector<unsigned char> Pixels;
+    bool                       Loaded = false;
+};
+
+/**
+ * @brief The glyphs of one font at one size, to be rasterized together
+ * @details Fill in the font, size and codepoints; rasterizeGlyphSets() fills glyphs, one per codepoint in the same order
+ */
+struct GlyphSet {
+    std::string              fontPath;
+    unsigned int             fontSize;
+    std::vector<char32_t>    codepoints;
+    std::vector<GlyphBitmap> glyphs;
+};
+
+/**
+ * @brief Renders one glyph of a face into a bitmap
+ *
+ * @param face The face, already sized
+ * @param codepoint The Unicode codepoint (the missing-glyph box if the face lacks it)
+ * @param glyph Receives the bitmap and metrics
+ * @return false if FreeType failed to render the glyph
+ */
+bool rasterizeGlyph(FT_Face face, char32_t codepoint, GlyphBitmap &glyph);
+
+/**
+ * @brief Rasterizes glyph sets on worker threads
+ * @details The codepoints of every set are split into chunks that the workers pull from a shared
+ * counter, so a single large set is spread over every core as well as many small ones. FreeType
+ * handles are not thread safe, so each worker opens its own FT_Library and its own FT_Face for
+ * every set it works on. No GL calls are made: upload the results on the GL thread afterwards.
+ *
+ * @param sets The sets to rasterize; their glyphs are filled in
+ * @param threadCount Number of workers, 0 for one per hardware thread
+ */
+void rasterizeGlyphSets(std::vector<GlyphSet> &sets, unsigned int threadCount = 0);
+
+#endif //GRAPHICS_GLYPHRASTERIZER_H
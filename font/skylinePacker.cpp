@@ -0,0 +1,72 @@
+#include "skylinePacker.h"
+
+#include <algorithm>
+#include <climits>
+
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+    reset();
+}
+
+bool SkylinePacker::pack(int w, int h, glm::ivec2 &origin) {
+    // bottom-left: lowest resulting top edge, ties go to the narrowest segment
+    int bestIndex = -1, bestY = INT_MAX, bestWidth = INT_MAX;
+    for (size_t i = 0; i < skyline.size(); i++) {
+        int y = fit(i, w, h);
+        if (y >= 0 && (y < bestY || (y == bestY && skyline[i].width < bestWidth))) {
+            bestIndex = static_cast<int>(i);
+            bestY = y;
+            bestWidth = skyline[i].width;
+        }
+    }
+    if (bestIndex < 0)
+        return false;
+
+    origin = glm::ivec2(skyline[bestIndex].x, bestY);
+    skyline.insert(skyline.begin() + bestIndex, {origin.x, bestY + h, w});
+
+    // the new segment covers the start of the ones after it: shrink or drop them
+    for (size_t i = bestIndex + 1; i < skyline.size();) {
+        const Node &previous = skyline[i - 1];
+        int overlap = previous.x + previous.width - skyline[i].x;
+        if (overlap <= 0)
+            break;
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width > 0)
+            break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else {
+            i++;
+        }
+    }
+    return true;
+}
+
+void SkylinePacker::reset() {
+    skyline.assign(1, {0, 0, width});
+}
+
+int SkylinePacker::fit(size_t index, int w, int h) const {
+    int x = skyline[index].x;
+    if (x + w > width)
+        return -1;
+
+    // rest on the highest segment under the rectangle
+    int y = skyline[index].y;
+    int widthLeft = w;
+    for (size_t i = index; widthLeft > 0; i++) {
+        y = std::max(y, skyline[i].y);
+        if (y + h > height)
+            return -1;
+        widthLeft -= skyline[i].width;
+    }
+    return y;
+}
@@ -0,0 +1,49 @@
+#ifndef GRAPHICS_SKYLINEPACKER_H
+#define GRAPHICS_SKYLINEPACKER_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Packs rectangles into a fixed-size area with the skyline bottom-left heuristic
+ * @details The packer tracks the top edge ("skyline") of everything placed so far as a list of
+ * horizontal segments and puts each new rectangle where its top ends up lowest. Rectangles can't be
+ * removed individually; reset() empties the whole area.
+ */
+class SkylinePacker {
+    public:
+        /**
+         * @brief Construct a new Skyline Packer object
+         *
+         * @param width Width of the area
+         * @param height Height of the area
+         */
+        SkylinePacker(int width, int height);
+
+        /**
+         * @brief Finds room for a rectangle and reserves it
+         *
+         * @param w Width of the rectangle
+         * @param h Height of the rectangle
+         * @param origin Set to the top-left corner of the reserved space
+         * @return false if the rectangle does not fit anywhere
+         */
+        bool pack(int w, int h, glm::ivec2 &origin);
+
+        /// @brief Frees the whole area
+        void reset();
+
+    private:
+        /// @brief A horizontal segment of the skyline: [x, x + width) is filled up to y
+        struct Node {
+            int x, y, width;
+        };
+
+        int width, height;
+        std::vector<Node> skyline;
+
+        /// @brief The y a w*h rectangle would sit at when its left edge is at node index, or -1 if it can't
+        int fit(size_t index, int w, int h) const;
+};
+
+#endif //GRAPHICS_SKYLINEPACKER_H
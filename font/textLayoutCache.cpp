@@ -0,0 +1,66 @@
+#include "textLayoutCache.h"
+#include "../util/hash.h"
+
+#include <glad/glad.h>
+
+TextLayoutCache::TextLayoutCache(unsigned long maxUnusedFrames) : maxUnusedFrames(maxUnusedFrames) {}
+
+TextLayoutCache::~TextLayoutCache() {
+    for (auto &iter: layouts)
+        release(iter.second);
+}
+
+TextLayoutCache::Layout *TextLayoutCache::find(const std::string &text, float x, float y, float scale, unsigned int color) {
+    auto found = layouts.find({text, x, y, scale, color});
+    if (found == layouts.end())
+        return nullptr;
+    found->second.lastUsed = frame;
+    return &found->second;
+}
+
+TextLayoutCache::Layout &TextLayoutCache::insert(const std::string &text, float x, float y, float scale, unsigned int color) {
+    Layout &layout = layouts[{text, x, y, scale, color}];
+    release(layout);
+    glGenVertexArrays(1, &layout.VAO);
+    glGenBuffers(1, &layout.VBO);
+    layout.lastUsed = frame;
+    return layout;
+}
+
+void TextLayoutCache::endFrame() {
+    frame++;
+    for (auto iter = layouts.begin(); iter != layouts.end();) {
+        if (frame - iter->second.lastUsed > maxUnusedFrames) {
+            release(iter->second);
+            iter = layouts.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+size_t TextLayoutCache::size() const {
+    return layouts.size();
+}
+
+void TextLayoutCache::release(Layout &layout) {
+    if (layout.VAO)
+        glDeleteVertexArrays(1, &layout.VAO);
+    if (layout.VBO)
+        glDeleteBuffers(1, &layout.VBO);
+    layout = Layout();
+}
+
+bool TextLayoutCache::Key::operator==(const Key &other) const {
+    return x == other.x && y == other.y && scale == other.scale && color == other.color && text == other.text;
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const Key &key) const {
+    uint64_t hash = fnv1a(key.text);
+    hash = fnv1a(reinterpret_cast<const char *>(&key.x), sizeof(float), hash);
+    hash = fnv1a(reinterpret_cast<const char *>(&key.y), sizeof(float), hash);
+    hash = fnv1a(reinterpret_cast<const char *>(&key.scale), sizeof(float), hash);
+    hash = fnv1a(reinterpret_cast<const char *>(&key.color), sizeof(unsigned int), hash);
+    return static_cast<size_t>(hash);
+}
@@ -0,0 +1,82 @@
+#ifndef GRAPHICS_TEXTLAYOUTCACHE_H
+#define GRAPHICS_TEXTLAYOUTCACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief A range of text vertices that all sample the same atlas page
+struct TextRun {
+    unsigned int texture;
+    int first;
+    int count;
+};
+
+/**
+ * @brief GPU-resident vertex data of text that is drawn the same way frame after frame
+ * @details Entries are keyed by (string, scale, position, color), each holding its own VAO and static
+ * VBO, so a cached string is redrawn with one call and no layout or upload work. Entries that
+ * have not been used for a number of frames are evicted by endFrame().
+ */
+class TextLayoutCache {
+    public:
+        /// @brief A cached layout ready to draw
+        struct Layout {
+            unsigned int VAO = 0, VBO = 0;
+            /// @brief The vertices of the VBO, split by atlas page
+            std::vector<TextRun> runs;
+            /// @brief Glyph cache generation the UVs were built against
+            unsigned long generation = 0;
+            /// @brief Frame the layout was last drawn in
+            unsigned long lastUsed = 0;
+        };
+
+        /**
+         * @brief Construct a new Text Layout Cache object
+         *
+         * @param maxUnusedFrames Frames an entry may go unused before it is evicted
+         */
+        explicit TextLayoutCache(unsigned long maxUnusedFrames = 120);
+
+        /// @brief Deletes the buffers of every entry
+        ~TextLayoutCache();
+
+        /**
+         * @brief Looks up a layout and marks it used this frame
+         * @return The layout, or nullptr if it has to be built
+         */
+        Layout* find(const std::string &text, float x, float y, float scale, unsigned int color);
+
+        /**
+         * @brief Creates an empty entry (VAO and VBO generated, nothing uploaded yet)
+         * @return The new layout, marked used this frame
+         */
+        Layout& insert(const std::string &text, float x, float y, float scale, unsigned int color);
+
+        /// @brief Advances the frame counter and evicts stale entries
+        void endFrame();
+
+        /// @brief Number of cached layouts
+        size_t size() const;
+
+    private:
+        struct Key {
+            std::string text;
+            float x, y, scale;
+            unsigned int color;
+            bool operator==(const Key &other) const;
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key &key) const;
+        };
+
+        std::unordered_map<Key, Layout, KeyHash> layouts;
+        unsigned long frame = 0;
+        unsigned long maxUnusedFrames;
+
+        /// @brief Deletes the GL objects of a layout
+        static void release(Layout &layout);
+};
+
+#endif //GRAPHICS_TEXTLAYOUTCACHE_H
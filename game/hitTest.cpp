@@ -0,0 +1,95 @@
+#include "hitTest.h"
+#include "../util/bits.h"
+
+#include <cstring>
+
+#if !defined(GRAPHICS_NO_SIMD) && defined(__AVX2__)
+#define HITTEST_AVX2
+#include <immintrin.h>
+#elif !defined(GRAPHICS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define HITTEST_SSE2
+#include <emmintrin.h>
+#elif !defined(GRAPHICS_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define HITTEST_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+    /// @brief Closest hit so far
+    struct Nearest {
+        int index = -1;
+        float distanceSq = 0.0f;
+    };
+
+    /// @brief Squared distance of circle i from the point (same operations as the vector paths)
+    inline float distanceSq(const float* x, const float* y, size_t i, glm::vec2 point) {
+        float dx = point.x - x[i];
+        float dy = point.y - y[i];
+        return dx * dx + dy * dy;
+    }
+
+    /// @brief Records the hits of one block: a bit per lane of the block starting at base
+    inline void recordBlock(unsigned int bits, size_t base, const float* x, const float* y, glm::vec2 point,
+                            uint64_t* mask, Nearest& nearest) {
+        if (mask)
+            mask[base / 64] |= static_cast<uint64_t>(bits) << (base % 64);
+        // hits are rare, so finding the nearest among them is left to scalar code
+        while (bits) {
+            unsigned int lane = lowestBit(bits);
+            bits &= bits - 1;
+            float d = distanceSq(x, y, base + lane, point);
+            if (nearest.index < 0 || d < nearest.distanceSq)
+                nearest = {static_cast<int>(base + lane), d};
+        }
+    }
+}
+
+int hitTestCircles(const float *x, const float *y, const float *radiusSq, size_t count, glm::vec2 point, uint64_t *mask) {
+    if (mask)
+        std::memset(mask, 0, (count + 63) / 64 * sizeof(uint64_t));
+
+    Nearest nearest;
+    size_t i = 0;
+
+#if defined(HITTEST_AVX2)
+    const __m256 px = _mm256_set1_ps(point.x), py = _mm256_set1_ps(point.y);
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(px, _mm256_loadu_ps(x + i));
+        __m256 dy = _mm256_sub_ps(py, _mm256_loadu_ps(y + i));
+        __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        unsigned int bits = _mm256_movemask_ps(_mm256_cmp_ps(d, _mm256_loadu_ps(radiusSq + i), _CMP_LT_OQ));
+        if (bits)
+            recordBlock(bits, i, x, y, point, mask, nearest);
+    }
+#elif defined(HITTEST_SSE2)
+    const __m128 px = _mm_set1_ps(point.x), py = _mm_set1_ps(point.y);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(px, _mm_loadu_ps(x + i));
+        __m128 dy = _mm_sub_ps(py, _mm_loadu_ps(y + i));
+        __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        unsigned int bits = _mm_movemask_ps(_mm_cmplt_ps(d, _mm_loadu_ps(radiusSq + i)));
+        if (bits)
+            recordBlock(bits, i, x, y, point, mask, nearest);
+    }
+#elif defined(HITTEST_NEON)
+    const float32x4_t px = vdupq_n_f32(point.x), py = vdupq_n_f32(point.y);
+    const uint32_t laneBits[4] = {1, 2, 4, 8};
+    const uint32x4_t weights = vld1q_u32(laneBits);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t dx = vsubq_f32(px, vld1q_f32(x + i));
+        float32x4_t dy = vsubq_f32(py, vld1q_f32(y + i));
+        // separate multiply and add (no fused vfmaq), to round like the other paths
+        float32x4_t d = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        unsigned int bits = vaddvq_u32(vandq_u32(vcltq_f32(d, vld1q_f32(radiusSq + i)), weights));
+        if (bits)
+            recordBlock(bits, i, x, y, point, mask, nearest);
+    }
+#endif
+
+    // what is left over (everything, in the scalar build)
+    for (; i < count; i++) {
+        if (distanceSq(x, y, i, point) < radiusSq[i])
+            recordBlock(1u, i, x, y, point, mask, nearest);
+    }
+    return nearest.index;
+}
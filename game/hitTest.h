@@ -0,0 +1,25 @@
+#ifndef GRAPHICS_HITTEST_H
+#define GRAPHICS_HITTEST_H
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Tests one point against many circles stored as separate x, y and radius² arrays
+ * @details A circle is hit if the point is strictly inside it, so clicks in the corners of a target's
+ * bounding square miss. The arrays are read in blocks of 8 (AVX2), 4 (SSE2 or AArch64 NEON) or one at
+ * a time, whichever the build targets; define GRAPHICS_NO_SIMD to force the scalar loop.
+ *
+ * @param x Circle centers, x
+ * @param y Circle centers, y
+ * @param radiusSq Squared circle radii
+ * @param count Number of circles
+ * @param point The point to test
+ * @param mask If not nullptr, (count + 63) / 64 words that receive one bit per circle (bit i % 64 of word i / 64), set if hit
+ * @return The index of the hit circle whose center is nearest the point (the lowest such index on a tie), or -1
+ */
+int hitTestCircles(const float* x, const float* y, const float* radiusSq, size_t count, glm::vec2 point, uint64_t* mask = nullptr);
+
+#endif //GRAPHICS_HITTEST_H
@@ -0,0 +1,330 @@
+#include "simulation.h"
+
+#include "hitTest.h"
+#include "../input/inputSystem.h"
+#include "../util/bits.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    /// @brief How fast the arrow keys move a slider, in pixels per second (3.8 px per frame at 60 fps)
+    constexpr float SLIDER_SPEED = 228.0f;
+    /// @brief Height of a slider's row (the height of its handle)
+    constexpr float SLIDER_SIZE = 80.0f;
+    /// @brief Seconds the settings screen waits before starting the round on its own
+    constexpr double SETTINGS_TIMEOUT = 20.0;
+    /// @brief Smallest grid cell; targets smaller than this share cells rather than spread over many tiny ones
+    constexpr float MIN_CELL_SIZE = 32.0f;
+    /// @brief Most targets alive at once; the store and the grid are allocated for this many up front
+    constexpr unsigned int MAX_TARGETS = 4096;
+    /// @brief A tick this far behind schedule (a suspended process, a debugger) resyncs instead of catching up
+    constexpr double MAX_LAG = 0.25;
+
+    const char* SLIDER_TYPES[4] = {"size", "speed", "count", "time"};
+}
+
+Simulation::Simulation(unsigned int width, unsigned int height, uint64_t seed, double tickRate)
+        : width(width), height(height), period(1.0 / tickRate),
+          targets(MAX_TARGETS), grid(width, height, MAX_TARGETS, MIN_CELL_SIZE),
+          seed(seed), positions(seed, static_cast<uint64_t>(RandomStream::Position)),
+          colors(seed, static_cast<uint64_t>(RandomStream::Color)) {
+    //the sliders start in the middle, at the same rows as the buttons that draw them
+    const float rows[4] = {11.5f, 8.5f, 5.5f, 2.5f};
+    for (int i = 0; i < 4; i++)
+        sliders[i] = {vec2(width / 2.0f, rows[i] * height / 16.0f), false};
+
+    finalSize = value(width/2, "size");
+    finalSpeed = value(width/2, "speed");
+    finalCount = value(width/2, "count");
+    finalTime = value(width/2, "time");
+
+    // the first snapshot is there before the thread runs, so the renderer never reads an empty one
+    double start = InputSystem::now();
+    publish(start);
+    snapshots.update();
+
+    worker = std::thread(&Simulation::run, this, start);
+}
+
+Simulation::~Simulation() {
+    running.store(false, std::memory_order_release);
+    if (worker.joinable())
+        worker.join();
+}
+
+void Simulation::post(const vector<InputEvent> &posted) {
+    for (const InputEvent& event : posted) {
+        if (!events.push(event) && !overflowReported) {
+            std::cout << "| WARNING::SIMULATION: input queue full, dropping events" << std::endl;
+            overflowReported = true;
+        }
+    }
+}
+
+TripleBuffer<GameSnapshot> &Simulation::getSnapshots() {
+    return snapshots;
+}
+
+double Simulation::getTickPeriod() const {
+    return period;
+}
+
+Screen Simulation::getScreen() const {
+    return publishedScreen.load(std::memory_order_relaxed);
+}
+
+void Simulation::run(double start) {
+    using Clock = std::chrono::steady_clock;
+    // tick n simulates start + n * period and is released when the steady clock gets there
+    Clock::time_point origin = Clock::now();
+    double time = start;
+
+    while (running.load(std::memory_order_acquire)) {
+        time += period;
+        Clock::time_point deadline = origin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(time - start));
+        Clock::time_point now = Clock::now();
+        if (now - deadline > std::chrono::duration<double>(MAX_LAG)) {
+            origin = now;
+            start = time = InputSystem::now();
+        }
+        else if (deadline > now) {
+            // no need to spin: events carry their own timestamps, so waking late only delays the snapshot
+            std::this_thread::sleep_until(deadline);
+        }
+        // ticks that fell behind run back to back until the schedule is met again
+
+        tick(time);
+        publish(time);
+    }
+}
+
+void Simulation::tick(double time) {
+    input.clearEdges();
+
+    // apply what happened up to this tick in order; later events stay queued for their own tick
+    while (const InputEvent* event = events.peek()) {
+        if (event->time > time)
+            break;
+        input.apply(*event);
+        if (screen == Screen::Play && event->type == InputEventType::MouseButton
+                && event->code == GLFW_MOUSE_BUTTON_LEFT && event->action == GLFW_PRESS)
+            click(*event);
+        events.pop();
+    }
+
+    //a key counts if it is held, or if it was tapped within this tick
+    auto key = [this](int code) { return input.isKeyDown(code) || input.wasKeyPressed(code); };
+
+    //the start screen moves on to the settings on an 's', and the settings to the round on a 'g'
+    //or once the user has spent 20 seconds on them
+    if (screen == Screen::Start && key(GLFW_KEY_S)) {
+        screen = Screen::Settings;
+        settingsTime = time;
+    }
+    if (screen == Screen::Settings) {
+        if (key(GLFW_KEY_G) || time - settingsTime >= SETTINGS_TIMEOUT) {
+            startTime = time;
+            gameTime = 0.0;
+            screen = Screen::Play;
+            //a fresh score for the round
+            hits = 0;
+            misses = 0;
+            reactionTotal = 0.0;
+            //the streams start over, so the round's targets depend only on the seed and the settings,
+            //not on how long the menus took; the first batch appears right away
+            positions.seed(seed, static_cast<uint64_t>(RandomStream::Position));
+            colors.seed(seed, static_cast<uint64_t>(RandomStream::Color));
+            spawnTargets(time);
+        }
+        else {
+            updateSliders();
+        }
+    }
+
+    //an 'a' after the round restarts the game, for a continuous training loop
+    if (screen == Screen::Over && key(GLFW_KEY_A))
+        screen = Screen::Start;
+
+    //during the round, the next batch of targets replaces the last one once the user dictated finalSpeed has passed
+    if (screen == Screen::Play && time - lastSpawn >= finalSpeed)
+        spawnTargets(time);
+
+    //let the user know that they are hovering in the right place (only the targets near the cursor are
+    //tested, in one batch)
+    vec2 mouse(input.getCursor().x, height - input.getCursor().y);
+    for (const TargetGrid::Block* block = grid.query(mouse); block; block = grid.next(block)) {
+        uint64_t bits = 0;
+        hitTestCircles(block->x, block->y, block->radiusSq, block->count, mouse, &bits);
+        for (; bits; bits &= bits - 1)
+            targets.setHovered(block->index[lowestBit(bits)]);
+    }
+
+    //the round is over once its time exceeds the user-defined finalTime
+    if (screen == Screen::Play) {
+        gameTime = time - startTime;
+        if (gameTime >= finalTime) {
+            targets.clear();
+            grid.clear();
+            screen = Screen::Over;
+        }
+    }
+}
+
+void Simulation::click(const InputEvent &event) {
+    //every click is scored once, at the position and time it happened: it either hits one target (which is
+    //deleted and increments the score) or counts as one miss
+    int index = targetAt(vec2(event.cursor.x, height - event.cursor.y));
+    if (index < 0) {
+        misses++;
+        return;
+    }
+    hits++;
+    //reaction time from the target appearing to the click itself
+    reactionTotal += event.time - targets.getSpawnTime(index);
+
+    //a hit target is deleted: out of the grid, then out of the store, whose last target takes its slot
+    grid.remove(index, targets.getPos(index), targets.getRadius(index));
+    unsigned int moved = targets.remove(index);
+    if (moved != static_cast<unsigned int>(index))
+        grid.rename(moved, index, targets.getPos(index), targets.getRadius(index));
+}
+
+int Simulation::targetAt(vec2 point) const {
+    //exact circles, so a click in the corner of a target's bounding square misses it; where targets
+    //overlap, the one whose center is nearest the click takes it
+    int nearest = -1;
+    float nearestDistance = 0.0f;
+    for (const TargetGrid::Block* block = grid.query(point); block; block = grid.next(block)) {
+        int slot = hitTestCircles(block->x, block->y, block->radiusSq, block->count, point);
+        if (slot < 0)
+            continue;
+        vec2 offset = vec2(block->x[slot], block->y[slot]) - point;
+        float distance = glm::dot(offset, offset);
+        //the blocks of a cell are in no particular order, so a tie goes to the lower slot
+        unsigned int index = block->index[slot];
+        if (nearest < 0 || distance < nearestDistance || (distance == nearestDistance && index < static_cast<unsigned int>(nearest))) {
+            nearest = static_cast<int>(index);
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
+
+void Simulation::updateSliders() {
+    vec2 mouse(input.getCursor().x, height - input.getCursor().y);
+    //the sliders follow the mouse while the left button is held
+    bool press = input.isButtonDown(GLFW_MOUSE_BUTTON_LEFT);
+    float low = 1.8f * width / 8, high = 6.2f * width / 8;
+    float step = SLIDER_SPEED * static_cast<float>(period);
+
+    for (int i = 0; i < 4; i++) {
+        Slider& slider = sliders[i];
+        //a slider only reacts while the mouse is on its row
+        slider.hovered = mouse.y < slider.pos.y + SLIDER_SIZE / 2 && mouse.y > slider.pos.y - SLIDER_SIZE / 2;
+        if (!slider.hovered)
+            continue;
+
+        //the arrow keys move the slider, within its boundaries
+        if (input.isKeyDown(GLFW_KEY_LEFT))
+            slider.pos.x -= step;
+        if (input.isKeyDown(GLFW_KEY_RIGHT))
+            slider.pos.x += step;
+        if (slider.pos.x < low)
+            slider.pos.x = low;
+        if (slider.pos.x > high)
+            slider.pos.x = high;
+
+        //the mouse can also dictate the slider's position
+        if (mouse.x > low && mouse.x < high && press)
+            slider.pos.x = mouse.x;
+
+        //update the setting the slider controls
+        int setting = value(slider.pos.x, SLIDER_TYPES[i]);
+        switch (static_cast<SliderKind>(i)) {
+            case SliderKind::Size:  finalSize = setting; break;
+            case SliderKind::Speed: finalSpeed = setting; break;
+            case SliderKind::Count: finalCount = setting; break;
+            case SliderKind::Time:  finalTime = setting; break;
+        }
+    }
+}
+
+void Simulation::spawnTargets(double time) {
+    //the new batch reuses the slots and grid blocks of the last one, nothing is allocated
+    targets.clear();
+    //cells about one target across, so a target is listed in at most four of them
+    grid.reset(std::max(finalSize, MIN_CELL_SIZE));
+    int count = std::min(finalCount, static_cast<int>(MAX_TARGETS));
+    //drawn in batches, a whole batch's positions and then its colors
+    constexpr int BATCH = 64;
+    uint32_t xs[BATCH], ys[BATCH], channels[3 * BATCH];
+    for (int first = 0; first < count; first += BATCH) {
+        int batch = std::min(BATCH, count - first);
+        positions.fill(xs, batch, static_cast<uint32_t>(width));
+        positions.fill(ys, batch, static_cast<uint32_t>(height));
+        colors.fill(channels, 3 * batch, 10);
+        for (int i = 0; i < batch; i++) {
+            //random positions and colors (each channel one of 0, 0.1, ... 0.9), all targets the size dictated by the user
+            vec2 pos(xs[i], ys[i]);
+            vec4 color(channels[3 * i] / 10.0f, channels[3 * i + 1] / 10.0f, channels[3 * i + 2] / 10.0f, 1.0f);
+            //spawned on the same clock as the input events, for the reaction times
+            unsigned int index = targets.add(pos, finalSize / 2.0f, color, time);
+            grid.insert(index, pos, finalSize / 2.0f);
+        }
+    }
+    lastSpawn = time;
+}
+
+void Simulation::publish(double time) {
+    GameSnapshot& snapshot = snapshots.back();
+    snapshot.tick = tickCount++;
+    snapshot.time = time;
+    snapshot.screen = screen;
+    // copy-assignment reuses the slot's capacity
+    snapshot.targets = targets;
+    for (int i = 0; i < 4; i++)
+        snapshot.sliders[i] = sliders[i];
+    snapshot.timeLeft = static_cast<float>(finalTime - gameTime);
+    snapshot.finalTime = finalTime;
+    snapshot.hits = hits;
+    snapshot.misses = misses;
+    snapshot.accuracy = hits / float(hits + misses);
+    snapshot.reactionTotal = reactionTotal;
+    snapshots.publish();
+    publishedScreen.store(screen, std::memory_order_relaxed);
+}
+
+int Simulation::value(float item, const string& type) {
+    //a function to help find the value from the slider's position, by putting their positions into
+    //a linear function with a predefined range
+    //the ranges are 5 to 105 for the size, 1 to 5 for the speed, 1 to 6 for the target count, and
+    //15 to 61 for the time
+
+    //this turns the slider's literal width (say, 375) into a float with a decimal, to represent
+    //it's value out of 8, with the low bound of the slider being 1.8/8 and the high being 6.2/8
+    item = item/175;
+
+
+    if(type == "size") {
+        //the function for finding the size value
+        return 252/11 * (item - 1.8) + 5;
+    }
+    if(type == "speed") {
+        //the function for finding the speed value
+        return (0.92 * (item - 1.8) + 1);
+    }
+    if(type == "count") {
+        //the function for finding the count value
+        return 1.15 * (item - 1.8) + 1;
+    }
+
+    if(type == "time") {
+        //the function for finding the time value
+        return 10.5 * (item - 1.8) + 15;
+    }
+    else {
+        return 0;
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef GRAPHICS_SIMULATION_H
+#define GRAPHICS_SIMULATION_H
+
+#include "targetGrid.h"
+#include "targetStore.h"
+#include "../input/inputState.h"
+#include "../util/random.h"
+#include "../util/spscQueue.h"
+#include "../util/tripleBuffer.h"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::vector, std::string, glm::vec2, glm::vec4;
+
+/// @brief The screens of the game
+enum class Screen { Start, Settings, Play, Over };
+
+/// @brief The settings sliders, in the order they are stored in a GameSnapshot
+enum class SliderKind { Size, Speed, Count, Time };
+
+/// @brief One settings slider
+struct Slider {
+    /// @brief The center of the slider handle
+    vec2 pos;
+    /// @brief True while the cursor is on the slider's row
+    bool hovered;
+};
+
+/**
+ * @brief Everything the renderer needs to draw one simulation tick
+ * @details Published by the Simulation through a triple buffer and never changed once published.
+ */
+struct GameSnapshot {
+    /// @brief Counts the ticks, so a new snapshot can be told from a repeated one
+    unsigned long tick = 0;
+    /// @brief The time the tick simulated, on the InputSystem::now() clock
+    double time = 0.0;
+
+    Screen screen = Screen::Start;
+    /// @brief The live targets (hit ones are gone)
+    TargetStore targets;
+    Slider sliders[4]{};
+
+    /// @brief Seconds left in the round
+    float timeLeft = 0.0f;
+    /// @brief The length of the round in seconds
+    int finalTime = 0;
+
+    /// @brief Targets hit and clicks that missed this round, and their ratio
+    int hits = 0;
+    int misses = 0;
+    float accuracy = 0.0f;
+    /// @brief Sum of the reaction times (seconds from spawn to click) of the targets hit
+    double reactionTotal = 0.0;
+};
+
+/**
+ * @brief Runs the game logic (spawning, hit resolution, timers, settings) on its own thread at a fixed tick
+ * @details The input thread forwards its events with post() through a wait-free ring; each tick
+ * applies the events stamped up to the tick's time, advances the game by exactly one period and
+ * publishes a GameSnapshot. The render thread reads the newest snapshot with getSnapshots() and interpolates
+ * between the last two, so neither the frame rate nor a stall in glfwSwapBuffers changes what the
+ * game does: clicks are still resolved at the time and position they happened.
+ *
+ * The simulation makes no GL calls; targets are plain data (a TargetStore) that the renderer draws
+ * from the snapshot.
+ */
+class Simulation {
+    public:
+        /**
+         * @brief Construct a new Simulation object and start its thread
+         *
+         * @param width The width of the play field (the window)
+         * @param height The height of the play field
+         * @param seed Seeds the random streams; every round with the same seed and settings spawns the same targets
+         * @param tickRate Ticks per second
+         */
+        Simulation(unsigned int width, unsigned int height, uint64_t seed, double tickRate = 1000.0);
+
+        /**
+         * @brief Destroy the Simulation object
+         * @details Stops and joins the thread
+         */
+        ~Simulation();
+
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+
+        /**
+         * @brief Hands input events to the simulation (one producer thread only, the one polling GLFW)
+         * @details Never blocks; if the ring is full the newest events are dropped with a warning
+         *
+         * @param events Events in the order they happened
+         */
+        void post(const vector<InputEvent>& events);
+
+        /// @brief The snapshots published by the simulation; read them from one thread only
+        TripleBuffer<GameSnapshot>& getSnapshots();
+
+        /// @brief Seconds between two ticks
+        double getTickPeriod() const;
+
+        /// @brief The screen of the newest snapshot, for threads that don't read the snapshots
+        Screen getScreen() const;
+
+        /// @brief Maps a slider position to the setting it selects
+        static int value(float item, const string& type);
+
+    private:
+        const float width, height;
+        const double period;
+
+        std::thread worker;
+        std::atomic<bool> running{true};
+
+        /// @brief Events posted and not yet applied; the oldest one may be waiting for its tick
+        /// @details Room for several seconds of 1000 Hz mouse motion
+        SpscQueue<InputEvent, 8192> events;
+
+        /// @brief Set once post() has had to drop events, so the warning is printed only once (producer only)
+        bool overflowReported = false;
+
+        TripleBuffer<GameSnapshot> snapshots;
+        std::atomic<Screen> publishedScreen{Screen::Start};
+
+        // ---- game state, simulation thread only ----
+
+        InputState input;
+        Screen screen = Screen::Start;
+        TargetStore targets;
+        /// @brief The targets by position, for the hover and click queries (kept in step with the store's slots)
+        TargetGrid grid;
+        /// @brief The session seed; every round restarts the random streams from it
+        const uint64_t seed;
+        /// @brief Where and in which color targets spawn, one stream each (see RandomStream)
+        Pcg32 positions, colors;
+        Slider sliders[4]{};
+        unsigned long tickCount = 0;
+
+        //the time the game entered settings and play, and the last batch of targets spawned
+        double settingsTime = 0.0;
+        double startTime = 0.0;
+        double lastSpawn = 0.0;
+        double gameTime = 0.0;
+
+        //settings chosen with the sliders (these defaults are the sliders' starting positions)
+        float finalSize, finalSpeed;
+        int finalCount, finalTime;
+
+        //score of the round
+        int hits = 0, misses = 0;
+        double reactionTotal = 0.0;
+
+        /// @brief The simulation thread: ticks until stopped
+        void run(double start);
+
+        /**
+         * @brief Advances the game by one period
+         *
+         * @param time The time the tick simulates; events stamped up to it are applied first
+         */
+        void tick(double time);
+
+        /// @brief Resolves one left click at the position it happened
+        void click(const InputEvent& event);
+
+        /// @brief The live target containing the point whose center is nearest to it, or -1
+        int targetAt(vec2 point) const;
+
+        /// @brief Moves and reads back the sliders (settings screen)
+        void updateSliders();
+
+        /// @brief Replaces the targets with a new batch
+        void spawnTargets(double time);
+
+        /// @brief Writes the state into the back snapshot and publishes it
+        void publish(double time);
+};
+
+#endif //GRAPHICS_SIMULATION_H
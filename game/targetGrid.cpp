@@ -0,0 +1,168 @@
+#include "targetGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+TargetGrid::TargetGrid(float width, float height, unsigned int maxTargets, float minCellSize)
+        : width(width), height(height), minCellSize(minCellSize) {
+    // the smallest cells need the most heads
+    reset(minCellSize);
+
+    // a target no wider than a cell is listed in at most four cells; every block but the first of
+    // each cell is full, so this many blocks always suffice
+    size_t entries = static_cast<size_t>(maxTargets) * 4;
+    blocks.resize(entries / BLOCK_SIZE + std::min(heads.size(), entries) + 1);
+    clear();
+}
+
+void TargetGrid::reset(float cellSize) {
+    this->cellSize = std::max(cellSize, minCellSize);
+    columns = std::max(1, static_cast<int>(std::ceil(width / this->cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(height / this->cellSize)));
+    // only grows in the constructor, where the cells are the smallest
+    if (heads.size() < static_cast<size_t>(columns) * rows)
+        heads.resize(static_cast<size_t>(columns) * rows);
+    clear();
+}
+
+void TargetGrid::clear() {
+    std::fill(heads.begin(), heads.end(), -1);
+    // chain every block into the free list
+    for (size_t i = 0; i < blocks.size(); i++)
+        blocks[i].next = i + 1 < blocks.size() ? static_cast<int>(i + 1) : -1;
+    freeBlocks = blocks.empty() ? -1 : 0;
+}
+
+void TargetGrid::insert(unsigned int index, vec2 pos, float radius) {
+    int left, bottom, right, top;
+    if (!cellRange(pos, radius, left, bottom, right, top))
+        return;
+    for (int y = bottom; y <= top; y++)
+        for (int x = left; x <= right; x++)
+            append(y * columns + x, index, pos, radius * radius);
+}
+
+void TargetGrid::remove(unsigned int index, vec2 pos, float radius) {
+    int left, bottom, right, top;
+    if (!cellRange(pos, radius, left, bottom, right, top))
+        return;
+    for (int y = bottom; y <= top; y++)
+        for (int x = left; x <= right; x++)
+            erase(y * columns + x, index);
+}
+
+void TargetGrid::rename(unsigned int from, unsigned int to, vec2 pos, float radius) {
+    int left, bottom, right, top;
+    if (!cellRange(pos, radius, left, bottom, right, top))
+        return;
+    int block;
+    unsigned int slot;
+    for (int y = bottom; y <= top; y++)
+        for (int x = left; x <= right; x++)
+            if (find(y * columns + x, from, block, slot))
+                blocks[block].index[slot] = to;
+}
+
+void TargetGrid::move(unsigned int index, vec2 from, vec2 to, float radius) {
+    int fromLeft, fromBottom, fromRight, fromTop, toLeft, toBottom, toRight, toTop;
+    bool wasInside = cellRange(from, radius, fromLeft, fromBottom, fromRight, fromTop);
+    bool isInside = cellRange(to, radius, toLeft, toBottom, toRight, toTop);
+    // the cells keep the centers too, so even a move within the same cells has to update them
+    if (wasInside && isInside && fromLeft == toLeft && fromBottom == toBottom && fromRight == toRight && fromTop == toTop) {
+        int block;
+        unsigned int slot;
+        for (int y = toBottom; y <= toTop; y++) {
+            for (int x = toLeft; x <= toRight; x++) {
+                if (find(y * columns + x, index, block, slot)) {
+                    blocks[block].x[slot] = to.x;
+                    blocks[block].y[slot] = to.y;
+                }
+            }
+        }
+        return;
+    }
+    remove(index, from, radius);
+    insert(index, to, radius);
+}
+
+const TargetGrid::Block *TargetGrid::query(vec2 point) const {
+    if (!(point.x >= 0.0f && point.x < width && point.y >= 0.0f && point.y < height))
+        return nullptr;
+    int x = std::min(static_cast<int>(point.x / cellSize), columns - 1);
+    int y = std::min(static_cast<int>(point.y / cellSize), rows - 1);
+    int head = heads[y * columns + x];
+    return head < 0 ? nullptr : &blocks[head];
+}
+
+const TargetGrid::Block *TargetGrid::next(const Block *block) const {
+    return block->next < 0 ? nullptr : &blocks[block->next];
+}
+
+void TargetGrid::append(int cell, unsigned int index, vec2 pos, float radiusSq) {
+    int head = heads[cell];
+    if (head < 0 || blocks[head].count == BLOCK_SIZE) {
+        // the first block is full: a fresh one from the pool goes in front of it
+        if (freeBlocks < 0) {
+            if (!exhaustedReported) {
+                std::cout << "| WARNING::TARGETGRID: more targets than the grid was sized for, some can't be hit" << std::endl;
+                exhaustedReported = true;
+            }
+            return;
+        }
+        int fresh = freeBlocks;
+        freeBlocks = blocks[fresh].next;
+        blocks[fresh].count = 0;
+        blocks[fresh].next = head;
+        heads[cell] = head = fresh;
+    }
+    Block& block = blocks[head];
+    block.x[block.count] = pos.x;
+    block.y[block.count] = pos.y;
+    block.radiusSq[block.count] = radiusSq;
+    block.index[block.count] = index;
+    block.count++;
+}
+
+void TargetGrid::erase(int cell, unsigned int index) {
+    int block;
+    unsigned int slot;
+    if (!find(cell, index, block, slot))
+        return;
+
+    // order within a cell doesn't matter, so the last entry of the (only partly filled) first block fills the hole
+    int first = heads[cell];
+    Block& head = blocks[first];
+    Block& hole = blocks[block];
+    unsigned int last = head.count - 1;
+    hole.x[slot] = head.x[last];
+    hole.y[slot] = head.y[last];
+    hole.radiusSq[slot] = head.radiusSq[last];
+    hole.index[slot] = head.index[last];
+    if (--head.count == 0) {
+        // back to the pool
+        heads[cell] = head.next;
+        head.next = freeBlocks;
+        freeBlocks = first;
+    }
+}
+
+bool TargetGrid::find(int cell, unsigned int index, int &block, unsigned int &slot) const {
+    for (block = heads[cell]; block >= 0; block = blocks[block].next) {
+        const Block& candidate = blocks[block];
+        for (slot = 0; slot < candidate.count; slot++)
+            if (candidate.index[slot] == index)
+                return true;
+    }
+    return false;
+}
+
+bool TargetGrid::cellRange(vec2 pos, float radius, int &left, int &bottom, int &right, int &top) const {
+    if (pos.x + radius < 0.0f || pos.x - radius >= width || pos.y + radius < 0.0f || pos.y - radius >= height)
+        return false;
+    left = std::clamp(static_cast<int>(std::floor((pos.x - radius) / cellSize)), 0, columns - 1);
+    right = std::clamp(static_cast<int>(std::floor((pos.x + radius) / cellSize)), 0, columns - 1);
+    bottom = std::clamp(static_cast<int>(std::floor((pos.y - radius) / cellSize)), 0, rows - 1);
+    top = std::clamp(static_cast<int>(std::floor((pos.y + radius) / cellSize)), 0, rows - 1);
+    return true;
+}
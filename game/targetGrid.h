@@ -0,0 +1,112 @@
+#ifndef GRAPHICS_TARGETGRID_H
+#define GRAPHICS_TARGETGRID_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+using std::vector, glm::vec2;
+
+/**
+ * @brief Uniform grid over the play field that finds the targets near a point
+ * @details Each target is listed in every cell its bounding square overlaps, so a point query only
+ * has to look at the one cell containing the point. With the cell size at least a target's diameter
+ * a target is in at most four cells. The grid is kept up to date incrementally: insert() on spawn,
+ * move() when a target moves and remove() when it is hit, never rebuilt per query.
+ *
+ * Targets are identified by their index in the caller's storage. A cell lists its targets in a chain
+ * of fixed-size blocks, each holding centers and squared radii as separate arrays, so the exact test
+ * (hitTestCircles()) runs straight over a block without gathering anything. Only the first block of
+ * a chain is ever partly filled. All blocks come from a pool sized once in the constructor for the
+ * most targets the grid has to hold, so inserting and removing never allocate.
+ */
+class TargetGrid {
+    public:
+        /// @brief Entries per block
+        static constexpr unsigned int BLOCK_SIZE = 16;
+
+        /// @brief Up to BLOCK_SIZE targets of one cell, as parallel arrays (in no particular order)
+        struct Block {
+            float x[BLOCK_SIZE], y[BLOCK_SIZE], radiusSq[BLOCK_SIZE];
+            /// @brief The caller's index of each target
+            unsigned int index[BLOCK_SIZE];
+            unsigned int count;
+            /// @brief The next block of the cell (or of the free list), -1 at the end
+            int next;
+        };
+
+        /**
+         * @brief Construct a new Target Grid object
+         * @details Allocates everything the grid will ever use
+         *
+         * @param width The width of the play field
+         * @param height The height of the play field
+         * @param maxTargets The most targets listed at once (each no wider than a cell)
+         * @param minCellSize The smallest cell size reset() will use
+         */
+        TargetGrid(float width, float height, unsigned int maxTargets, float minCellSize);
+
+        /**
+         * @brief Empties the grid and changes its cell size
+         *
+         * @param cellSize The side of a cell (raised to the minimum cell size)
+         */
+        void reset(float cellSize);
+
+        /// @brief Empties the grid, keeping the cell size
+        void clear();
+
+        /// @brief Lists a target in the cells it overlaps
+        void insert(unsigned int index, vec2 pos, float radius);
+
+        /// @brief Removes a target (pos and radius must be the ones it was inserted with)
+        void remove(unsigned int index, vec2 pos, float radius);
+
+        /// @brief Changes the index a target is listed under (when the caller's storage moved it)
+        void rename(unsigned int from, unsigned int to, vec2 pos, float radius);
+
+        /// @brief Moves a target (updated in place while it stays within the same cells)
+        void move(unsigned int index, vec2 from, vec2 to, float radius);
+
+        /**
+         * @brief The targets that may contain a point
+         *
+         * @return The first block of the point's cell, nullptr if the cell is empty or the point is off the field
+         */
+        const Block* query(vec2 point) const;
+
+        /// @brief The block after this one in its cell, or nullptr
+        const Block* next(const Block* block) const;
+
+    private:
+        const float width, height;
+        const float minCellSize;
+        float cellSize = 0.0f;
+        int columns = 0, rows = 0;
+
+        /// @brief First block of each cell (row by row), -1 if empty; sized for the smallest cells
+        vector<int> heads;
+
+        /// @brief Every block, in a cell's chain or on the free list
+        vector<Block> blocks;
+        int freeBlocks = -1;
+
+        /// @brief Set once the pool ran dry, so the warning is printed only once
+        bool exhaustedReported = false;
+
+        /// @brief Adds an entry to a cell, starting a new block if the first one is full
+        void append(int cell, unsigned int index, vec2 pos, float radiusSq);
+
+        /// @brief Removes an entry from a cell, filling the hole with the last entry of the first block
+        void erase(int cell, unsigned int index);
+
+        /// @brief Finds an entry of a cell
+        /// @return false if the index isn't listed in the cell
+        bool find(int cell, unsigned int index, int& block, unsigned int& slot) const;
+
+        /// @brief The range of cells a target's bounding square overlaps
+        /// @return false if it lies completely outside the play field
+        bool cellRange(vec2 pos, float radius, int& left, int& bottom, int& right, int& top) const;
+};
+
+#endif //GRAPHICS_TARGETGRID_H
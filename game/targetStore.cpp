@@ -0,0 +1,64 @@
+#include "targetStore.h"
+
+#include <algorithm>
+
+TargetStore::TargetStore(size_t capacity) {
+    reserve(capacity);
+}
+
+TargetStore::TargetStore(const TargetStore &other) : TargetStore(other.capacity()) {
+    *this = other;
+}
+
+TargetStore &TargetStore::operator=(const TargetStore &other) {
+    if (this == &other)
+        return *this;
+    // grows once to the other store's capacity, after that only the live slots are copied
+    reserve(other.capacity());
+    count = other.count;
+    std::copy_n(other.x.begin(), count, x.begin());
+    std::copy_n(other.y.begin(), count, y.begin());
+    std::copy_n(other.radius.begin(), count, radius.begin());
+    std::copy_n(other.color.begin(), count, color.begin());
+    std::copy_n(other.spawnTime.begin(), count, spawnTime.begin());
+    std::copy_n(other.state.begin(), count, state.begin());
+    return *this;
+}
+
+void TargetStore::reserve(size_t count) {
+    if (count <= capacity())
+        return;
+    x.resize(count);
+    y.resize(count);
+    radius.resize(count);
+    color.resize(count);
+    spawnTime.resize(count);
+    state.resize(count);
+}
+
+unsigned int TargetStore::add(vec2 pos, float radius, vec4 color, double spawnTime) {
+    // past the pool only if the caller spawns more than it was built for
+    if (count == capacity())
+        reserve(std::max<size_t>(16, 2 * capacity()));
+    x[count] = pos.x;
+    y[count] = pos.y;
+    this->radius[count] = radius;
+    this->color[count] = color;
+    this->spawnTime[count] = spawnTime;
+    state[count] = 0;
+    return static_cast<unsigned int>(count++);
+}
+
+unsigned int TargetStore::remove(unsigned int index) {
+    unsigned int last = static_cast<unsigned int>(count - 1);
+    if (index != last) {
+        x[index] = x[last];
+        y[index] = y[last];
+        radius[index] = radius[last];
+        color[index] = color[last];
+        spawnTime[index] = spawnTime[last];
+        state[index] = state[last];
+    }
+    count--;
+    return last;
+}
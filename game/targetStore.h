@@ -0,0 +1,91 @@
+#ifndef GRAPHICS_TARGETSTORE_H
+#define GRAPHICS_TARGETSTORE_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using std::vector, glm::vec2, glm::vec4;
+
+/**
+ * @brief The live confetti targets, stored as one contiguous array per field
+ * @details Position, radius, color, spawn time and state each live in their own array, indexed by
+ * the target's slot, so a loop that needs only some of the fields (hit testing, drawing, stats)
+ * streams through just those. Every target in the store is live: remove() moves the last target
+ * into the freed slot (swap and pop), so dead targets are never drawn or tested and the arrays stay
+ * packed. A removal therefore changes the slot of one other target, see remove().
+ *
+ * The arrays are a pool allocated once for the store's capacity: clear() and remove() only change the
+ * count and add() writes into the next free slot, so a new round reuses the slots of the last one.
+ * Copying a store copies just its live targets, and copying into a store that is already as large
+ * reuses its memory, so the snapshots taken every tick don't allocate either.
+ */
+class TargetStore {
+    public:
+        /// @brief State bit: the cursor has been over the target
+        static constexpr uint8_t HOVERED = 1;
+
+        /// @brief Construct an empty Target Store object, with no slots allocated yet
+        TargetStore() : TargetStore(0) {}
+
+        /**
+         * @brief Construct a new Target Store object
+         *
+         * @param capacity The number of slots allocated up front
+         */
+        explicit TargetStore(size_t capacity);
+
+        TargetStore(const TargetStore& other);
+        TargetStore& operator=(const TargetStore& other);
+
+        /// @brief Number of live targets
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        /// @brief Number of slots allocated; add() only allocates beyond this
+        size_t capacity() const { return x.size(); }
+
+        /// @brief Makes room for count targets up front
+        void reserve(size_t count);
+
+        /// @brief Removes every target, keeping the slots for the next ones
+        void clear() { count = 0; }
+
+        /**
+         * @brief Appends a target
+         *
+         * @param pos The center
+         * @param radius The radius
+         * @param color The fill color
+         * @param spawnTime When the target appeared, on the InputSystem::now() clock
+         * @return The slot of the new target
+         */
+        unsigned int add(vec2 pos, float radius, vec4 color, double spawnTime);
+
+        /**
+         * @brief Removes a target by moving the last one into its slot
+         *
+         * @param index The slot to free
+         * @return The slot the moved target used to have (equal to index if nothing had to move)
+         */
+        unsigned int remove(unsigned int index);
+
+        vec2 getPos(unsigned int index) const { return {x[index], y[index]}; }
+        float getRadius(unsigned int index) const { return radius[index]; }
+        vec4 getColor(unsigned int index) const { return color[index]; }
+        double getSpawnTime(unsigned int index) const { return spawnTime[index]; }
+        bool isHovered(unsigned int index) const { return (state[index] & HOVERED) != 0; }
+
+        void setHovered(unsigned int index) { state[index] |= HOVERED; }
+
+    private:
+        /// @brief The live targets are the first count slots
+        size_t count = 0;
+
+        vector<float> x, y, radius;
+        vector<vec4> color;
+        vector<double> spawnTime;
+        vector<uint8_t> state;
+};
+
+#endif //GRAPHICS_TARGETSTORE_H
@@ -0,0 +1,67 @@
+#include "inputState.h"
+
+void InputState::apply(const InputEvent &event) {
+    // every event carries the cursor position it happened at
+    cursor = event.cursor;
+
+    // GLFW_KEY_UNKNOWN (-1) has no slot in the bitsets
+    if (event.type == InputEventType::Key && event.code >= 0 && event.code <= GLFW_KEY_LAST) {
+        if (event.action == GLFW_PRESS) {
+            keysDown.set(event.code);
+            keysPressed.set(event.code);
+        }
+        else if (event.action == GLFW_RELEASE) {
+            keysDown.reset(event.code);
+            keysReleased.set(event.code);
+        }
+    }
+    else if (event.type == InputEventType::MouseButton && event.code >= 0 && event.code <= GLFW_MOUSE_BUTTON_LAST) {
+        if (event.action == GLFW_PRESS) {
+            buttonsDown.set(event.code);
+            buttonsPressed.set(event.code);
+        }
+        else if (event.action == GLFW_RELEASE) {
+            buttonsDown.reset(event.code);
+            buttonsReleased.set(event.code);
+        }
+    }
+}
+
+void InputState::clearEdges() {
+    keysPressed.reset();
+    keysReleased.reset();
+    buttonsPressed.reset();
+    buttonsReleased.reset();
+}
+
+bool InputState::isKeyDown(int key) const {
+    return key >= 0 && key <= GLFW_KEY_LAST && keysDown[key];
+}
+
+bool InputState::wasKeyPressed(int key) const {
+    return key >= 0 && key <= GLFW_KEY_LAST && keysPressed[key];
+}
+
+bool InputState::wasKeyReleased(int key) const {
+    return key >= 0 && key <= GLFW_KEY_LAST && keysReleased[key];
+}
+
+bool InputState::isButtonDown(int button) const {
+    return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && buttonsDown[button];
+}
+
+bool InputState::wasButtonPressed(int button) const {
+    return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && buttonsPressed[button];
+}
+
+bool InputState::wasButtonReleased(int button) const {
+    return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && buttonsReleased[button];
+}
+
+glm::dvec2 InputState::getCursor() const {
+    return cursor;
+}
+
+void InputState::setCursor(glm::dvec2 position) {
+    cursor = position;
+}
@@ -0,0 +1,70 @@
+#ifndef GRAPHICS_INPUTSTATE_H
+#define GRAPHICS_INPUTSTATE_H
+
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include <bitset>
+
+/// @brief What kind of input an InputEvent describes
+enum class InputEventType { Key, MouseButton, CursorMove };
+
+/**
+ * @brief One input event, in the order GLFW delivered it
+ *
+ * @param type Key, mouse button or cursor motion
+ * @param code The GLFW key or mouse button (unused for cursor motion)
+ * @param action GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT (unused for cursor motion)
+ * @param mods The GLFW modifier bits held at the time
+ * @param cursor The cursor position when the event arrived (window coordinates, y down)
+ * @param time Seconds on the InputSystem::now() clock when the event arrived
+ */
+struct InputEvent {
+    InputEventType type;
+    int code;
+    int action;
+    int mods;
+    glm::dvec2 cursor;
+    double time;
+};
+
+/**
+ * @brief Held keys and buttons, their pressed/released edges and the cursor, built from InputEvents
+ * @details Whoever consumes the event stream keeps one: the InputSystem for the thread that polls
+ * GLFW, the Simulation for its own ticks. Edges accumulate until clearEdges().
+ */
+class InputState {
+    public:
+        /// @brief Updates the state with one event
+        void apply(const InputEvent& event);
+
+        /// @brief Forgets the pressed/released edges, keeping what is held
+        void clearEdges();
+
+        /// @brief True while the key is held
+        bool isKeyDown(int key) const;
+        /// @brief True if the key went down since the last clearEdges()
+        bool wasKeyPressed(int key) const;
+        /// @brief True if the key went up since the last clearEdges()
+        bool wasKeyReleased(int key) const;
+
+        /// @brief True while the mouse button is held
+        bool isButtonDown(int button) const;
+        /// @brief True if the mouse button went down since the last clearEdges()
+        bool wasButtonPressed(int button) const;
+        /// @brief True if the mouse button went up since the last clearEdges()
+        bool wasButtonReleased(int button) const;
+
+        /// @brief The cursor position of the latest event (window coordinates, y down)
+        glm::dvec2 getCursor() const;
+
+        /// @brief Sets the cursor position before any event has carried one
+        void setCursor(glm::dvec2 position);
+
+    private:
+        std::bitset<GLFW_KEY_LAST + 1> keysDown, keysPressed, keysReleased;
+        std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> buttonsDown, buttonsPressed, buttonsReleased;
+        glm::dvec2 cursor{0.0};
+};
+
+#endif //GRAPHICS_INPUTSTATE_H
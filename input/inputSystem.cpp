@@ -0,0 +1,140 @@
+#include "inputSystem.h"
+
+#include <algorithm>
+#include <cstring>
+
+InputSystem::InputSystem(GLFWwindow *window) : window(window) {
+    // unaccelerated motion straight from the device (takes effect while the cursor is disabled)
+    if (glfwRawMouseMotionSupported())
+        glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+
+    int windowWidth, windowHeight;
+    glfwGetWindowSize(window, &windowWidth, &windowHeight);
+    bounds = glm::dvec2(windowWidth, windowHeight);
+
+    glm::dvec2 cursor;
+    glfwGetCursorPos(window, &cursor.x, &cursor.y);
+    state.setCursor(cursor);
+    publishCursor(cursor);
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+}
+
+InputSystem::~InputSystem() {
+    glfwSetKeyCallback(window, nullptr);
+    glfwSetMouseButtonCallback(window, nullptr);
+    glfwSetCursorPosCallback(window, nullptr);
+    glfwSetWindowUserPointer(window, nullptr);
+}
+
+void InputSystem::poll(double timeout) {
+    state.clearEdges();
+    events.clear();
+
+    // the callbacks run inside these calls
+    if (timeout > 0.0)
+        glfwWaitEventsTimeout(timeout);
+    else
+        glfwPollEvents();
+}
+
+const std::vector<InputEvent> &InputSystem::getEvents() const {
+    return events;
+}
+
+bool InputSystem::isKeyDown(int key) const {
+    return state.isKeyDown(key);
+}
+
+bool InputSystem::wasKeyPressed(int key) const {
+    return state.wasKeyPressed(key);
+}
+
+bool InputSystem::wasKeyReleased(int key) const {
+    return state.wasKeyReleased(key);
+}
+
+bool InputSystem::isButtonDown(int button) const {
+    return state.isButtonDown(button);
+}
+
+bool InputSystem::wasButtonPressed(int button) const {
+    return state.wasButtonPressed(button);
+}
+
+bool InputSystem::wasButtonReleased(int button) const {
+    return state.wasButtonReleased(button);
+}
+
+glm::dvec2 InputSystem::getCursor() const {
+    return state.getCursor();
+}
+
+glm::vec2 InputSystem::getLatestCursor() const {
+    uint64_t packed = latestCursor.load(std::memory_order_acquire);
+    glm::vec2 position;
+    std::memcpy(&position.x, &packed, sizeof(float));
+    std::memcpy(&position.y, reinterpret_cast<const char *>(&packed) + sizeof(float), sizeof(float));
+    return position;
+}
+
+void InputSystem::setCursorMode(int mode) {
+    if (mode == cursorMode)
+        return;
+    glfwSetInputMode(window, GLFW_CURSOR, mode);
+    cursorMode = mode;
+}
+
+double InputSystem::now() {
+    // the raw timer, not glfwGetTime(): same clock, but no offset subtraction in double precision
+    static const double period = 1.0 / static_cast<double>(glfwGetTimerFrequency());
+    return static_cast<double>(glfwGetTimerValue()) * period;
+}
+
+glm::dvec2 InputSystem::confine(glm::dvec2 position) const {
+    // the virtual position of a captured cursor is unbounded; keep it on the play field
+    if (cursorMode != GLFW_CURSOR_DISABLED)
+        return position;
+    return glm::dvec2(std::clamp(position.x, 0.0, bounds.x - 1.0), std::clamp(position.y, 0.0, bounds.y - 1.0));
+}
+
+void InputSystem::publishCursor(glm::dvec2 position) {
+    glm::vec2 narrow(position);
+    uint64_t packed;
+    std::memcpy(&packed, &narrow.x, sizeof(float));
+    std::memcpy(reinterpret_cast<char *>(&packed) + sizeof(float), &narrow.y, sizeof(float));
+    latestCursor.store(packed, std::memory_order_release);
+}
+
+void InputSystem::push(InputEventType type, int code, int action, int mods, glm::dvec2 cursor) {
+    InputEvent event{type, code, action, mods, cursor, now()};
+    state.apply(event);
+    events.push_back(event);
+}
+
+void InputSystem::keyCallback(GLFWwindow *window, int key, int /*scancode*/, int action, int mods) {
+    auto *input = static_cast<InputSystem *>(glfwGetWindowUserPointer(window));
+    input->push(InputEventType::Key, key, action, mods, input->state.getCursor());
+}
+
+void InputSystem::mouseButtonCallback(GLFWwindow *window, int button, int action, int mods) {
+    auto *input = static_cast<InputSystem *>(glfwGetWindowUserPointer(window));
+    // the position at the moment of the click, including motion not yet delivered as a cursor event
+    glm::dvec2 cursor;
+    glfwGetCursorPos(window, &cursor.x, &cursor.y);
+    cursor = input->confine(cursor);
+    input->publishCursor(cursor);
+    input->push(InputEventType::MouseButton, button, action, mods, cursor);
+}
+
+void InputSystem::cursorPosCallback(GLFWwindow *window, double x, double y) {
+    auto *input = static_cast<InputSystem *>(glfwGetWindowUserPointer(window));
+    glm::dvec2 position = input->confine(glm::dvec2(x, y));
+    if (position.x != x || position.y != y)
+        glfwSetCursorPos(window, position.x, position.y);
+    input->publishCursor(position);
+    // cursor events arrive in order with the button events, so a click carries the position it happened at
+    input->push(InputEventType::CursorMove, 0, 0, 0, position);
+}
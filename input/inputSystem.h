@@ -0,0 +1,122 @@
+#ifndef GRAPHICS_INPUTSYSTEM_H
+#define GRAPHICS_INPUTSYSTEM_H
+
+#include "inputState.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Collects keyboard and mouse input through GLFW callbacks
+ * @details Key, mouse button and cursor callbacks are installed on the window (which points its
+ * user pointer at this object) and feed a timestamped event queue plus an InputState. Every click
+ * becomes its own event, so two clicks between frames are both seen; pressed/released edges are
+ * kept per frame, so a press that is also released before the frame still shows up as pressed.
+ *
+ * Raw (unaccelerated, unscaled) mouse motion is requested when the platform supports it; GLFW
+ * applies it while the cursor is disabled (captured). Events are stamped with the high-resolution
+ * GLFW timer and button events with the cursor position at that exact moment, so hits and reaction
+ * times can be judged per event rather than per frame.
+ *
+ * The newest cursor position is also published through an atomic, so another thread (the renderer)
+ * can sample it at the last moment with getLatestCursor(). While the cursor is disabled its virtual
+ * position is kept inside the window, so it always maps to a point on the play field.
+ *
+ * Call poll() from the main thread (GLFW only pumps events there) instead of glfwPollEvents().
+ */
+class InputSystem {
+    public:
+        /**
+         * @brief Construct a new Input System object
+         * @details Installs the callbacks and takes over the window user pointer
+         *
+         * @param window The window to read input from
+         */
+        explicit InputSystem(GLFWwindow* window);
+
+        /**
+         * @brief Destroy the Input System object
+         * @details Removes the callbacks
+         */
+        ~InputSystem();
+
+        InputSystem(const InputSystem&) = delete;
+        InputSystem& operator=(const InputSystem&) = delete;
+
+        /**
+         * @brief Clears the edges and events of the last poll and pumps GLFW's events
+         * @details With a timeout the call sleeps until an event arrives or the timeout expires, so
+         * events are stamped as soon as the platform delivers them without spinning in between.
+         *
+         * @param timeout Longest wait in seconds, 0 to return right away
+         */
+        void poll(double timeout = 0.0);
+
+        /// @brief The events that arrived during the last poll(), oldest first
+        const std::vector<InputEvent>& getEvents() const;
+
+        /// @brief True while the key is held
+        bool isKeyDown(int key) const;
+        /// @brief True if the key went down during the last poll()
+        bool wasKeyPressed(int key) const;
+        /// @brief True if the key went up during the last poll()
+        bool wasKeyReleased(int key) const;
+
+        /// @brief True while the mouse button is held
+        bool isButtonDown(int button) const;
+        /// @brief True if the mouse button went down during the last poll()
+        bool wasButtonPressed(int button) const;
+        /// @brief True if the mouse button went up during the last poll()
+        bool wasButtonReleased(int button) const;
+
+        /// @brief The latest cursor position (window coordinates, y down)
+        glm::dvec2 getCursor() const;
+
+        /// @brief The newest cursor position seen by the callbacks (window coordinates, y down)
+        /// @details Safe to call from any thread
+        glm::vec2 getLatestCursor() const;
+
+        /**
+         * @brief Sets how the OS cursor behaves over the window (main thread only)
+         * @details Does nothing if the mode is already set
+         *
+         * @param mode GLFW_CURSOR_NORMAL, GLFW_CURSOR_HIDDEN or GLFW_CURSOR_DISABLED (captured, raw motion)
+         */
+        void setCursorMode(int mode);
+
+        /// @brief Seconds on the clock events are stamped with (the raw GLFW timer)
+        /// @details Use it to timestamp anything that is compared with event times
+        static double now();
+
+    private:
+        GLFWwindow* window;
+
+        /// @brief Held keys and buttons, the edges of the current frame and the cursor
+        InputState state;
+        int cursorMode = GLFW_CURSOR_NORMAL;
+
+        /// @brief Size of the window, which bounds the cursor while it is disabled
+        glm::dvec2 bounds{0.0};
+
+        /// @brief getLatestCursor()'s position, as two packed floats
+        std::atomic<uint64_t> latestCursor{0};
+
+        /// @brief Keeps a position inside the window while the cursor is disabled (unchanged otherwise)
+        glm::dvec2 confine(glm::dvec2 position) const;
+
+        /// @brief Stores the position for getLatestCursor()
+        void publishCursor(glm::dvec2 position);
+
+        /// @brief Events of the current frame, appended to by the callbacks
+        std::vector<InputEvent> events;
+
+        /// @brief Records an event at the given cursor position, stamped with the current time
+        void push(InputEventType type, int code, int action, int mods, glm::dvec2 cursor);
+
+        static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+        static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+        static void cursorPosCallback(GLFWwindow* window, double x, double y);
+};
+
+#endif //GRAPHICS_INPUTSYSTEM_H
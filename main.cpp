@@ -1,18 +1,61 @@
 
 #include "engine.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
 
 
 int main(int argc, char *argv[]) {
-    Engine engine;
+    // frame pacing: --vsync (default), --uncapped or --fps=N
+    PacingMode pacing = PacingMode::VSync;
+    double fpsCap = 0.0;
+    // the targets' positions and colors: --seed=N repeats a session, otherwise a fresh one each run
+    uint64_t seed = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    // how the targets are drawn: --targets=disc (default), --targets=ring or --targets=outline
+    TargetStyle targetStyle = TargetStyle::Disc;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--vsync") == 0) {
+            pacing = PacingMode::VSync;
+        }
+        else if (std::strcmp(argv[i], "--uncapped") == 0) {
+            pacing = PacingMode::Uncapped;
+        }
+        else if (std::strncmp(argv[i], "--fps=", 6) == 0) {
+            pacing = PacingMode::Capped;
+            fpsCap = std::atof(argv[i] + 6);
+        }
+        else if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = std::strtoull(argv[i] + 7, nullptr, 0);
+        }
+        else if (std::strcmp(argv[i], "--targets=disc") == 0) {
+            targetStyle = TargetStyle::Disc;
+        }
+        else if (std::strcmp(argv[i], "--targets=ring") == 0) {
+            targetStyle = TargetStyle::Ring;
+        }
+        else if (std::strcmp(argv[i], "--targets=outline") == 0) {
+            targetStyle = TargetStyle::Outline;
+        }
+        else {
+            std::cout << "usage: " << argv[0] << " [--vsync | --uncapped | --fps=N] [--seed=N] [--targets=disc | ring | outline]" << std::endl;
+            return 1;
+        }
+    }
+
+    // printed so any session can be replayed
+    std::cout << "| SEED: " << seed << std::endl;
+    {
+        Engine engine(pacing, fpsCap, seed, targetStyle);
 
-    while (!engine.shouldClose()) {
-        engine.processInput();
-        engine.update();
-        engine.render();
+        // input is pumped on this thread, frames are drawn on the engine's render thread and the game
+        // logic ticks on its simulation thread
+        engine.run();
     }
 
+    // only once the engine is gone: its destructor still needs the context and GLFW (the loader
+    // window, the input callbacks)
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,79 @@
+#include "assetLoader.h"
+
+#include <chrono>
+#include <iostream>
+
+AssetLoader::AssetLoader(GLFWwindow *shared) {
+    // same context hints as the main window (still set from initWindow), but never shown
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    context = glfwCreateWindow(1, 1, "loader", nullptr, shared);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+    if (!context) {
+        std::cout << "| WARNING::ASSETLOADER: could not create a shared context, loading on the main thread" << std::endl;
+        return;
+    }
+    worker = std::thread(&AssetLoader::run, this);
+}
+
+AssetLoader::~AssetLoader() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+    if (context)
+        glfwDestroyWindow(context);
+}
+
+void AssetLoader::enqueue(Task task) {
+    if (!context) {
+        while (!task()) {}
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+void AssetLoader::run() {
+    glfwMakeContextCurrent(context);
+
+    // tasks that returned false since the last one that finished; once every queued task has been
+    // polled without progress, back off briefly instead of spinning on the driver
+    size_t idlePolls = 0;
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping)
+                break;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        if (task()) {
+            idlePolls = 0;
+            continue;
+        }
+
+        size_t queued;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+            queued = tasks.size();
+        }
+        if (++idlePolls >= queued) {
+            idlePolls = 0;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,68 @@
+#ifndef GRAPHICS_ASSETLOADER_H
+#define GRAPHICS_ASSETLOADER_H
+
+#include <GLFW/glfw3.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Runs asset loading work on a background thread with its own OpenGL context
+ * @details The loader creates a hidden window whose context shares objects (textures, buffers,
+ * programs) with the main window, and makes it current on its worker thread. Tasks can therefore
+ * read files, rasterize, compile and upload without stalling the render loop.
+ *
+ * A task returns true when it is done, or false to be run again later; this is how work that
+ * waits on the driver (e.g. parallel shader compiles) is polled without blocking other tasks.
+ * A task must glFinish() before publishing GL objects, so the main context sees them complete.
+ *
+ * If the shared context can't be created, enqueue() runs each task to completion on the calling
+ * thread instead, with the main context.
+ */
+class AssetLoader {
+    public:
+        /// @brief A unit of loading work, see the class description
+        using Task = std::function<bool()>;
+
+        /**
+         * @brief Construct a new Asset Loader object
+         * @details Must be called on the main thread (GLFW creates windows there only)
+         *
+         * @param shared The window whose context the loader context shares objects with
+         */
+        explicit AssetLoader(GLFWwindow* shared);
+
+        /**
+         * @brief Destroy the Asset Loader object
+         * @details Waits for the task in progress, drops the queued ones and destroys the loader context
+         */
+        ~AssetLoader();
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        /**
+         * @brief Queues a task for the loader thread
+         *
+         * @param task Returns true when done, false to be polled again
+         */
+        void enqueue(Task task);
+
+    private:
+        /// @brief The hidden window owning the loader context, nullptr if it couldn't be created
+        GLFWwindow* context = nullptr;
+
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Task> tasks;
+        bool stopping = false;
+
+        /// @brief The loader thread: runs tasks until stopped
+        void run();
+};
+
+#endif //GRAPHICS_ASSETLOADER_H
@@ -0,0 +1,59 @@
+#include "crosshairRenderer.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+CrosshairRenderer::CrosshairRenderer(Shader &shader, float length, float gap, float thickness) : shader(shader) {
+    // two triangles per rectangle, offsets from the center in pixels
+    std::vector<float> vertices;
+    auto addRect = [&vertices](float left, float bottom, float right, float top) {
+        vertices.insert(vertices.end(), {left, bottom, right, bottom, right, top,
+                                         left, bottom, right, top, left, top});
+    };
+    float half = thickness / 2.0f;
+    addRect(gap, -half, gap + length, half);      // right arm
+    addRect(-gap - length, -half, -gap, half);    // left arm
+    addRect(-half, gap, half, gap + length);      // top arm
+    addRect(-half, -gap - length, half, -gap);    // bottom arm
+    addRect(-half, -half, half, half);            // center dot
+    vertexCount = static_cast<int>(vertices.size() / 2);
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+CrosshairRenderer::~CrosshairRenderer() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+}
+
+void CrosshairRenderer::draw(vec2 pos) {
+    if (!shader.isReady())
+        return;
+    if (!uniformsResolved) {
+        modelUniform = shader.uniform<mat4>("model");
+        colorUniform = shader.uniform<vec4>("shapeColor");
+        uniformsResolved = true;
+    }
+
+    // whole pixels, so the even-width arms cover exactly two pixel rows/columns
+    vec2 center(std::round(pos.x), std::round(pos.y));
+
+    shader.use();
+    shader.setMatrix4(modelUniform, glm::translate(mat4(1.0f), glm::vec3(center, 0.0f)));
+    shader.setVector4f(colorUniform, color);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    glBindVertexArray(0);
+}
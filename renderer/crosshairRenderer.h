@@ -0,0 +1,57 @@
+#ifndef GRAPHICS_CROSSHAIRRENDERER_H
+#define GRAPHICS_CROSSHAIRRENDERER_H
+
+#include "../shader/shader.h"
+
+#include <glm/glm.hpp>
+
+using glm::vec2, glm::vec4, glm::mat4;
+
+/**
+ * @brief Draws the aiming crosshair that replaces the OS cursor
+ * @details Four arms around a gap plus a center dot, built once into a small static buffer and
+ * drawn with the shape shader. Moving the crosshair only changes the model uniform, so draw() can
+ * be called as the very last thing before swapping buffers, with a cursor position sampled at
+ * that moment; it bypasses the render queue for exactly that reason.
+ */
+class CrosshairRenderer {
+    public:
+        /**
+         * @brief Construct a new Crosshair Renderer object
+         *
+         * @param shader The shape shader (model matrix and shapeColor uniforms)
+         * @param length Length of each arm in pixels
+         * @param gap Distance from the center to the start of each arm
+         * @param thickness Width of the arms and the center dot
+         */
+        CrosshairRenderer(Shader& shader, float length = 10.0f, float gap = 4.0f, float thickness = 2.0f);
+
+        /**
+         * @brief Destroy the Crosshair Renderer object
+         * @details Deletes the VAO and VBO
+         */
+        ~CrosshairRenderer();
+
+        CrosshairRenderer(const CrosshairRenderer&) = delete;
+        CrosshairRenderer& operator=(const CrosshairRenderer&) = delete;
+
+        /**
+         * @brief Draws the crosshair right away (skipped while the shader is loading)
+         *
+         * @param pos The center, in window coordinates with y up
+         */
+        void draw(vec2 pos);
+
+    private:
+        Shader& shader;
+        unsigned int VAO, VBO;
+        int vertexCount;
+        const vec4 color{0.0f, 1.0f, 0.0f, 1.0f};
+
+        /// @brief Uniform handles, resolved on the first draw with a ready shader
+        Shader::Uniform<mat4> modelUniform;
+        Shader::Uniform<vec4> colorUniform;
+        bool uniformsResolved = false;
+};
+
+#endif //GRAPHICS_CROSSHAIRRENDERER_H
@@ -0,0 +1,99 @@
+#include "renderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+void RenderQueue::submit(const RenderCommand &command) {
+    entries.push_back({makeKey(command), command});
+}
+
+void RenderQueue::flush() {
+    // stable, so equal keys (e.g. the glyphs of one string) keep the order they were recorded in
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry &a, const Entry &b) { return a.key < b.key; });
+
+    unsigned int boundProgram = 0, boundTexture = 0, boundVAO = 0;
+    drawCalls = 0;
+    glActiveTexture(GL_TEXTURE0);
+
+    for (size_t i = 0; i < entries.size();) {
+        RenderCommand command = entries[i].command;
+        // shaders still loading asynchronously: skip the draw, it is recorded again next frame
+        if (!command.shader->isReady()) {
+            i++;
+            continue;
+        }
+        // swallow every following command that continues this one
+        size_t next = i + 1;
+        while (next < entries.size() && canMerge(command, entries[next].command)) {
+            command.count += entries[next].command.count;
+            next++;
+        }
+
+        // only touch state that actually changes
+        if (command.shader->ID != boundProgram) {
+            command.shader->use();
+            boundProgram = command.shader->ID;
+        }
+        if (command.texture != boundTexture) {
+            glBindTexture(GL_TEXTURE_2D, command.texture);
+            boundTexture = command.texture;
+        }
+        if (command.VAO != boundVAO) {
+            glBindVertexArray(command.VAO);
+            boundVAO = command.VAO;
+        }
+        if (command.modelUniform.location >= 0)
+            command.shader->setMatrix4(command.modelUniform, command.model);
+        if (command.colorUniform.location >= 0)
+            command.shader->setVector4f(command.colorUniform, command.color);
+
+        draw(command);
+        drawCalls++;
+        i = next;
+    }
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    entries.clear();
+}
+
+size_t RenderQueue::getDrawCalls() const {
+    return drawCalls;
+}
+
+uint64_t RenderQueue::makeKey(const RenderCommand &command) {
+    uint64_t shader = command.shader ? command.shader->ID : 0;
+    return static_cast<uint64_t>(command.layer) << 56
+           | (shader & 0xFFFF) << 40
+           | (static_cast<uint64_t>(command.texture) & 0xFFFF) << 24
+           | (static_cast<uint64_t>(command.VAO) & 0xFFFF) << 8;
+}
+
+bool RenderQueue::canMerge(const RenderCommand &a, const RenderCommand &b) {
+    return !a.indexed && !b.indexed
+           && a.instances == 1 && b.instances == 1
+           && a.layer == b.layer && a.shader->ID == b.shader->ID && a.texture == b.texture && a.VAO == b.VAO
+           && a.primitive == b.primitive
+           && a.first + a.count == b.first
+           && a.modelUniform.location == b.modelUniform.location
+           && a.colorUniform.location == b.colorUniform.location
+           && (a.modelUniform.location < 0 || std::memcmp(&a.model, &b.model, sizeof(mat4)) == 0)
+           && (a.colorUniform.location < 0 || std::memcmp(&a.color, &b.color, sizeof(vec4)) == 0);
+}
+
+void RenderQueue::draw(const RenderCommand &command) {
+    if (command.indexed) {
+        const void *offset = reinterpret_cast<const void *>(command.first * sizeof(unsigned int));
+        if (command.instances > 1)
+            glDrawElementsInstanced(command.primitive, command.count, GL_UNSIGNED_INT, offset, command.instances);
+        else
+            glDrawElements(command.primitive, command.count, GL_UNSIGNED_INT, offset);
+    }
+    else {
+        if (command.instances > 1)
+            glDrawArraysInstanced(command.primitive, command.first, command.count, command.instances);
+        else
+            glDrawArrays(command.primitive, command.first, command.count);
+    }
+}
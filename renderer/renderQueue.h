@@ -0,0 +1,81 @@
+#ifndef GRAPHICS_RENDERQUEUE_H
+#define GRAPHICS_RENDERQUEUE_H
+
+#include "../shader/shader.h"
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+using std::vector, glm::mat4, glm::vec4;
+
+/// @brief Draw order of the passes in a frame; later layers are drawn on top
+enum class RenderLayer : uint8_t { Background, Targets, Widgets, Text, Overlay };
+
+/**
+ * @brief One recorded draw call plus the state it needs
+ * @details Uniform handles left at location -1 are not uploaded.
+ */
+struct RenderCommand {
+    RenderLayer layer = RenderLayer::Background;
+    Shader* shader = nullptr;
+    /// @brief Texture bound to unit 0 (0 for none)
+    unsigned int texture = 0;
+    unsigned int VAO = 0;
+
+    GLenum primitive = GL_TRIANGLES;
+    /// @brief glDrawElements (unsigned int indices) instead of glDrawArrays
+    bool indexed = false;
+    /// @brief First vertex for array draws, first index for indexed draws
+    int first = 0;
+    int count = 0;
+    /// @brief More than 1 draws instanced
+    int instances = 1;
+
+    /// @brief Per-draw uniforms
+    Shader::Uniform<mat4> modelUniform;
+    mat4 model = mat4(1.0f);
+    Shader::Uniform<vec4> colorUniform;
+    vec4 color = vec4(1.0f);
+};
+
+/**
+ * @brief Collects the draws of a frame, then sorts and submits them with the fewest state changes
+ * @details Commands are sorted by (layer, shader, texture, VAO) and keep their submission order
+ * when the keys are equal. Adjacent non-indexed draws that share all state and read contiguous
+ * vertices are merged into a single draw call.
+ */
+class RenderQueue {
+    public:
+        /// @brief Records a command for this frame
+        void submit(const RenderCommand &command);
+
+        /// @brief Sorts, merges and draws every recorded command, then empties the queue
+        /// @details Commands whose shader is not ready yet (still loading) are dropped
+        void flush();
+
+        /// @brief Number of draw calls issued by the last flush()
+        size_t getDrawCalls() const;
+
+    private:
+        struct Entry {
+            uint64_t key;
+            RenderCommand command;
+        };
+
+        /// @brief The commands recorded since the last flush()
+        vector<Entry> entries;
+
+        size_t drawCalls = 0;
+
+        /// @brief Builds the sort key: layer, shader, texture and VAO from most to least significant
+        static uint64_t makeKey(const RenderCommand &command);
+
+        /// @brief True if b can be appended to a as part of the same draw call
+        static bool canMerge(const RenderCommand &a, const RenderCommand &b);
+
+        /// @brief Issues the draw call for one (possibly merged) command
+        static void draw(const RenderCommand &command);
+};
+
+#endif //GRAPHICS_RENDERQUEUE_H
@@ -0,0 +1,124 @@
+#include "streamBuffer.h"
+
+#include <GLFW/glfw3.h>
+#include <iostream>
+
+// glBufferStorage is GL 4.4 / GL_ARB_buffer_storage, so it is not part of the 3.3 core loader
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+typedef void (*BufferStorageProc)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+
+StreamBuffer::StreamBuffer(size_t size, unsigned int regions)
+        : size(size), regionSize(size / regions), fences(regions, nullptr) {
+    BufferStorageProc bufferStorage = nullptr;
+    if (glfwExtensionSupported("GL_ARB_buffer_storage"))
+        bufferStorage = reinterpret_cast<BufferStorageProc>(glfwGetProcAddress("glBufferStorage"));
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (bufferStorage) {
+        // map the whole ring once; coherent, so writes need no explicit flush
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        mapped = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+        if (!mapped) {
+            // immutable storage can't be respecified, so start over with a plain buffer
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        }
+    }
+    if (!mapped)
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+StreamBuffer::~StreamBuffer() {
+    for (size_t i = 0; i < fences.size(); i++)
+        waitForRegion(i);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (mapped || pendingUnmap)
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t bytes, size_t alignment) {
+    flush();
+
+    size_t regionStart = region * regionSize;
+    size_t offset = (head + alignment - 1) / alignment * alignment;
+    if (offset + bytes > regionStart + regionSize) {
+        // the frame wrote more than its region holds; the rest of the region still holds this frame's
+        // queued draws and the other regions may still be read by the GPU, so this draw is dropped
+        if (!overflowReported) {
+            std::cout << "| WARNING::STREAMBUFFER: frame data exceeds " << regionSize << " bytes, skipping draws" << std::endl;
+            overflowReported = true;
+        }
+        return {nullptr, 0};
+    }
+    head = offset + bytes;
+
+    if (mapped)
+        return {mapped + offset, offset};
+
+    // Fallback: this region was orphaned or never drawn from since, so no queued draw reads it
+    // and it can be mapped without synchronizing.
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    void *data = glMapBufferRange(GL_ARRAY_BUFFER, offset, bytes,
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    pendingUnmap = data != nullptr;
+    return {data, offset};
+}
+
+void StreamBuffer::flush() {
+    if (!pendingUnmap)
+        return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    pendingUnmap = false;
+}
+
+void StreamBuffer::endFrame() {
+    flush();
+    if (mapped)
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    region = (region + 1) % fences.size();
+    head = region * regionSize;
+
+    if (mapped) {
+        // usually long signaled: the fence is (regions - 1) frames old
+        waitForRegion(region);
+    }
+    else if (region == 0) {
+        // orphan: frames still in flight keep the old storage, we get fresh memory
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+unsigned int StreamBuffer::getBuffer() const {
+    return buffer;
+}
+
+void StreamBuffer::waitForRegion(size_t index) {
+    GLsync fence = fences[index];
+    if (!fence)
+        return;
+
+    // flush on the first wait so the fence is guaranteed to signal
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    // only a timeout waits again; signaled, failed or anything unexpected (no current context) ends the wait
+    while (glClientWaitSync(fence, flags, 1000000) == GL_TIMEOUT_EXPIRED) // 1 ms
+        flags = 0;
+    glDeleteSync(fence);
+    fences[index] = nullptr;
+}
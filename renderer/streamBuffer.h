@@ -0,0 +1,100 @@
+#ifndef GRAPHICS_STREAMBUFFER_H
+#define GRAPHICS_STREAMBUFFER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+/**
+ * @brief Ring-buffer allocator for vertex data that is rewritten every frame
+ * @details The buffer is split into one region per frame in flight, and each frame allocates
+ * from its own region. Draws may be recorded and submitted later in the frame (see RenderQueue),
+ * so a region is never reused before the frame that wrote it has been fenced.
+ *
+ * When GL_ARB_buffer_storage is available the whole buffer is mapped once, persistently and
+ * coherently, and written directly; endFrame() fences the region and the allocator waits on that
+ * fence before the region comes around again. Without the extension each allocation is mapped
+ * unsynchronized and the storage is orphaned whenever the ring wraps.
+ *
+ * Either way the buffer object itself never changes, so VAOs can point at getBuffer() once.
+ */
+class StreamBuffer {
+    public:
+        /// @brief A block of the ring the caller may write to until flush()
+        struct Allocation {
+            /// @brief CPU pointer to write the data to
+            void* data;
+            /// @brief Byte offset of the block in the buffer (a multiple of the requested alignment)
+            size_t offset;
+        };
+
+        /**
+         * @brief Construct a new Stream Buffer object
+         *
+         * @param size Total size of the ring in bytes
+         * @param regions Number of fence-protected regions (frames that may be in flight)
+         */
+        StreamBuffer(size_t size, unsigned int regions = 3);
+
+        /**
+         * @brief Destroy the Stream Buffer object
+         * @details Unmaps and deletes the buffer and any pending fences
+         */
+        ~StreamBuffer();
+
+        /**
+         * @brief Reserve space in this frame's region
+         * @details Everything a frame allocates must fit in one region (size / regions bytes). An
+         * allocation that doesn't fit fails rather than overwrite data already queued this frame.
+         *
+         * @param size Number of bytes needed
+         * @param alignment Alignment of the returned offset, usually the vertex stride
+         * @return Where to write the data; data is nullptr if it failed, and the draw should be skipped
+         */
+        Allocation allocate(size_t size, size_t alignment = 16);
+
+        /**
+         * @brief Publish the data written to the last allocation
+         * @details Must be called before drawing from it. A no-op for the persistent mapping.
+         */
+        void flush();
+
+        /**
+         * @brief Fence this frame's region and move on to the next one
+         * @details Call once per frame after the last draw that reads from the buffer.
+         */
+        void endFrame();
+
+        /// @brief The GL buffer object backing the ring
+        unsigned int getBuffer() const;
+
+    private:
+        unsigned int buffer;
+        size_t size;
+        size_t regionSize;
+
+        /// @brief The region the current frame allocates from
+        size_t region = 0;
+
+        /// @brief Next free byte in the ring
+        size_t head = 0;
+
+        /// @brief The persistent mapping, or nullptr when using the orphaning fallback
+        char* mapped = nullptr;
+
+        /// @brief True while an allocation is mapped in the fallback path
+        bool pendingUnmap = false;
+
+        /// @brief Set once a frame has overflowed its region, so the warning is printed only once
+        bool overflowReported = false;
+
+        /// @brief Fence guarding each region (nullptr if the GPU is known to be done with it)
+        vector<GLsync> fences;
+
+        /// @brief Waits until the GPU no longer reads the given region
+        void waitForRegion(size_t index);
+};
+
+#endif //GRAPHICS_STREAMBUFFER_H
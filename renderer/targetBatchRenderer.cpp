@@ -0,0 +1,93 @@
+#include "targetBatchRenderer.h"
+
+#include "../shapes/meshRegistry.h"
+
+#include <cstddef>
+#include <cstring>
+
+TargetBatchRenderer::TargetBatchRenderer(Shader &shader, StreamBuffer &stream, RenderQueue &queue)
+        : shader(shader), stream(stream), queue(queue) {
+    // the quad is shared with every Rect through the registry; only the VAO is ours,
+    // because it also carries the per-instance attribute layout
+    const Mesh &quad = MeshRegistry::instance().acquire(MeshKind::Rect);
+    indexCount = quad.indexCount;
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quad.VBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad.EBO);
+
+    // per-instance attributes, advanced once per target instead of once per vertex.
+    // Their pointers are set in draw(), since the instances move around the stream buffer.
+    for (unsigned int attribute = 1; attribute <= 3; attribute++) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    setStyle(TargetStyle::Disc);
+}
+
+TargetBatchRenderer::~TargetBatchRenderer() {
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void TargetBatchRenderer::setStyle(TargetStyle style) {
+    this->style = style;
+    styleDirty = true;
+}
+
+void TargetBatchRenderer::begin() {
+    instances.clear();
+}
+
+void TargetBatchRenderer::add(vec2 pos, vec2 size, vec4 color) {
+    instances.push_back({pos, size, packColor(color)});
+}
+
+void TargetBatchRenderer::draw() {
+    // program state, so it only has to be set when it changes (and the shader may still be loading)
+    if (styleDirty && shader.isReady()) {
+        shader.use();
+        shader.setInteger("style", static_cast<int>(style));
+        styleDirty = false;
+    }
+    if (instances.empty())
+        return;
+
+    size_t bytes = instances.size() * sizeof(Instance);
+    StreamBuffer::Allocation block = stream.allocate(bytes, sizeof(Instance));
+    if (!block.data)
+        return;
+    std::memcpy(block.data, instances.data(), bytes);
+    stream.flush();
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(block.offset + offsetof(Instance, pos)));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(block.offset + offsetof(Instance, size)));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), (void*)(block.offset + offsetof(Instance, color)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    RenderCommand command;
+    command.layer = RenderLayer::Targets;
+    command.shader = &shader;
+    command.VAO = VAO;
+    command.indexed = true;
+    command.count = static_cast<int>(indexCount);
+    command.instances = static_cast<int>(instances.size());
+    queue.submit(command);
+}
+
+unsigned int TargetBatchRenderer::packColor(const vec4 &c) {
+    auto channel = [](float v) {
+        return static_cast<unsigned int>(glm::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(c.r) | channel(c.g) << 8 | channel(c.b) << 16 | channel(c.a) << 24;
+}
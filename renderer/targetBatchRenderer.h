@@ -0,0 +1,123 @@
+#ifndef GRAPHICS_TARGETBATCHRENDERER_H
+#define GRAPHICS_TARGETBATCHRENDERER_H
+
+#include "../shader/shader.h"
+#include "streamBuffer.h"
+#include "renderQueue.h"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+using std::vector, glm::vec2, glm::vec4;
+
+/// @brief How the target shader shades each target (values match target.frag)
+enum class TargetStyle { Disc = 0, Ring = 1, Outline = 2 };
+
+/**
+ * @brief Draws every live target with a single instanced draw call
+ * @details Each target is one quad (the shared unit rect from the MeshRegistry) with per-instance data
+ * holding the position, size and packed RGBA color of each target. The disc, ring or outline is
+ * computed analytically per pixel in target.frag, with a one pixel anti-aliased edge.
+ * Call begin(), add() every target for the frame, then draw().
+ */
+class TargetBatchRenderer {
+    public:
+        /**
+         * @brief Construct a new Target Batch Renderer object
+         * @details Sets up the VAO over the shared quad mesh
+         *
+         * @param shader The target shader to draw with
+         * @param stream The stream buffer the instance data is written to
+         * @param queue The render queue the batch draw is recorded into
+         */
+        TargetBatchRenderer(Shader& shader, StreamBuffer& stream, RenderQueue& queue);
+
+        /**
+         * @brief Destroy the Target Batch Renderer object
+         * @details Deletes the VAO owned by the renderer
+         */
+        ~TargetBatchRenderer();
+
+        /**
+         * @brief Sets how every target is shaded
+         * @details Applied by the next draw() once the shader is ready
+         *
+         * @param style Filled disc, thick ring or thin outline
+         */
+        void setStyle(TargetStyle style);
+
+        /**
+         * @brief Starts a new batch, dropping the instances queued last frame
+         */
+        void begin();
+
+        /**
+         * @brief Queues one target for the current batch
+         *
+         * @param pos The center of the target
+         * @param size The width and height of the target (the width is the diameter)
+         * @param color The color of the target
+         */
+        void add(vec2 pos, vec2 size, vec4 color);
+
+        /**
+         * @brief Uploads the queued instances and records one instanced draw for all of them
+         * @details The draw is recorded into the render queue (targets layer) and issued when it is flushed
+         */
+        void draw();
+
+    private:
+        /**
+         * @brief Per-target data, laid out exactly as the instanced vertex attributes read it
+         * @details color is packed as RGBA8 and normalized to [0, 1] by the vertex fetch
+         */
+        struct Instance {
+            vec2 pos;
+            vec2 size;
+            unsigned int color;
+        };
+
+        /**
+         * @brief The shader to use
+         */
+        Shader& shader;
+
+        /**
+         * @brief The VAO of the batch
+         * @details The quad mesh buffers themselves belong to the MeshRegistry
+         */
+        unsigned int VAO;
+
+        /**
+         * @brief Ring buffer the instance data is streamed through each frame
+         */
+        StreamBuffer& stream;
+
+        /**
+         * @brief Queue the batch draw is recorded into
+         */
+        RenderQueue& queue;
+
+        /**
+         * @brief The style last set, and whether the shader still has to be told
+         */
+        TargetStyle style = TargetStyle::Disc;
+        bool styleDirty = false;
+
+        /**
+         * @brief Number of indices in the quad mesh
+         */
+        unsigned int indexCount;
+
+        /**
+         * @brief The instances queued since the last begin()
+         */
+        vector<Instance> instances;
+
+        /**
+         * @brief Packs a color into RGBA8 (red in the lowest byte)
+         */
+        static unsigned int packColor(const vec4& c);
+};
+
+#endif //GRAPHICS_TARGETBATCHRENDERER_H
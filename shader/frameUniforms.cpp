@@ -0,0 +1,22 @@
+#include "frameUniforms.h"
+
+#include <glad/glad.h>
+
+FrameUniforms::FrameUniforms() {
+    glGenBuffers(1, &UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, UBO);
+}
+
+FrameUniforms::~FrameUniforms() {
+    glDeleteBuffers(1, &UBO);
+}
+
+void FrameUniforms::update(const FrameUniformData &data) {
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniformData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, UBO);
+}
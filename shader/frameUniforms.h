@@ -0,0 +1,64 @@
+#ifndef GRAPHICS_FRAMEUNIFORMS_H
+#define GRAPHICS_FRAMEUNIFORMS_H
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+/// @brief Binding point of the per-frame uniform block
+/// @details Every shader that declares the block is pointed at it when it is linked (see Shader::compile).
+constexpr unsigned int FRAME_UNIFORM_BINDING = 0;
+
+/// @brief Name of the per-frame uniform block in GLSL
+constexpr const char *FRAME_UNIFORM_BLOCK = "Frame";
+
+/**
+ * @brief C++ mirror of the per-frame uniform block
+ * @details Must match this declaration in every shader, member for member:
+ *
+ *     layout (std140) uniform Frame {
+ *         mat4 projection;
+ *         mat4 view;
+ *         vec4 viewport;   // x, y, width, height
+ *         float time;      // seconds since glfwInit
+ *     };
+ */
+struct FrameUniformData {
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::vec4 viewport;
+    float time;
+    float padding[3] = {};
+};
+
+// std140: mat4 and vec4 are 16-byte aligned, a float is 4-byte aligned and the block size is
+// rounded up to 16. Any mismatch here means the GPU reads garbage, so fail the build instead.
+static_assert(sizeof(glm::mat4) == 64 && sizeof(glm::vec4) == 16, "glm types must be tightly packed");
+static_assert(offsetof(FrameUniformData, projection) == 0, "std140: projection at 0");
+static_assert(offsetof(FrameUniformData, view) == 64, "std140: view at 64");
+static_assert(offsetof(FrameUniformData, viewport) == 128, "std140: viewport at 128");
+static_assert(offsetof(FrameUniformData, time) == 144, "std140: time at 144");
+static_assert(sizeof(FrameUniformData) == 160, "std140: block size is a multiple of 16");
+
+/**
+ * @brief The uniform buffer holding FrameUniformData
+ * @details Updated and bound once per frame; shared by every shader declaring the Frame block,
+ * so projection and view are no longer uploaded per shader or per draw.
+ */
+class FrameUniforms {
+    public:
+        /// @brief Creates the buffer and binds it to FRAME_UNIFORM_BINDING
+        FrameUniforms();
+
+        /// @brief Deletes the buffer
+        ~FrameUniforms();
+
+        /// @brief Uploads this frame's values and (re)binds the buffer
+        /// @param data The values for this frame
+        void update(const FrameUniformData &data);
+
+    private:
+        /// @brief The uniform buffer object
+        unsigned int UBO;
+};
+
+#endif //GRAPHICS_FRAMEUNIFORMS_H
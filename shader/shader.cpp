@@ -1,4 +1,76 @@
 #include "shader.h"
+#include "frameUniforms.h"
+#include "../util/hash.h"
+
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstring>
+
+// program binaries are GL 4.1 / GL_ARB_get_program_binary, so they are not part of the 3.3 core loader
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+// parallel compiles are GL_KHR_parallel_shader_compile (or the older ARB variant)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (*MaxShaderCompilerThreadsProc)(GLuint count);
+typedef void (*ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+typedef void (*GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (*ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+
+namespace {
+    /// @brief The program binary entry points, all null if unsupported
+    struct ProgramBinaryProcs {
+        ProgramParameteriProc programParameteri = nullptr;
+        GetProgramBinaryProc getProgramBinary = nullptr;
+        ProgramBinaryProc programBinary = nullptr;
+    };
+
+    /// @brief Loads the entry points the first time it is called (needs a current context)
+    const ProgramBinaryProcs &programBinaryProcs() {
+        static ProgramBinaryProcs procs = [] {
+            ProgramBinaryProcs loaded;
+            int formats = 0;
+            if (glfwExtensionSupported("GL_ARB_get_program_binary"))
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            // some drivers expose the extension but no format to store programs in
+            if (formats > 0) {
+                loaded.programParameteri = reinterpret_cast<ProgramParameteriProc>(glfwGetProcAddress("glProgramParameteri"));
+                loaded.getProgramBinary = reinterpret_cast<GetProgramBinaryProc>(glfwGetProcAddress("glGetProgramBinary"));
+                loaded.programBinary = reinterpret_cast<ProgramBinaryProc>(glfwGetProcAddress("glProgramBinary"));
+                if (!loaded.programParameteri || !loaded.getProgramBinary || !loaded.programBinary)
+                    loaded = ProgramBinaryProcs();
+            }
+            return loaded;
+        }();
+        return procs;
+    }
+
+    /// @brief The parallel compile entry point, null if unsupported
+    struct ParallelCompileProcs {
+        MaxShaderCompilerThreadsProc maxShaderCompilerThreads = nullptr;
+    };
+
+    /// @brief Loads the entry point the first time it is called (needs a current context)
+    const ParallelCompileProcs &parallelCompileProcs() {
+        static ParallelCompileProcs procs = [] {
+            ParallelCompileProcs loaded;
+            if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+                loaded.maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+            else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+                loaded.maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+            return loaded;
+        }();
+        return procs;
+    }
+}
 
 Shader &Shader::use() {
     glUseProgram(this->ID);
@@ -6,82 +78,231 @@ Shader &Shader::use() {
 }
 
 void Shader::compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource) {
-    unsigned int sVertex, sFragment, gShader;
+    beginCompile(vertexSource, fragmentSource, geometrySource);
+    finishCompile();
+}
+
+void Shader::beginCompile(const char* vertexSource, const char* fragmentSource, const char* geometrySource) {
+    // let the driver compile on as many threads as it likes (a per-context setting; one context per thread here)
+    static thread_local bool compilerThreadsSet = false;
+    if (!compilerThreadsSet && parallelCompileProcs().maxShaderCompilerThreads) {
+        parallelCompileProcs().maxShaderCompilerThreads(0xFFFFFFFF);
+        compilerThreadsSet = true;
+    }
 
     // vertex Shader
-    sVertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(sVertex, 1, &vertexSource, NULL);
-    glCompileShader(sVertex);
-    checkCompileErrors(sVertex, "VERTEX");
+    stages[0] = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(stages[0], 1, &vertexSource, NULL);
+    glCompileShader(stages[0]);
 
     // fragment Shader
-    sFragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(sFragment, 1, &fragmentSource, NULL);
-    glCompileShader(sFragment);
-    checkCompileErrors(sFragment, "FRAGMENT");
+    stages[1] = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(stages[1], 1, &fragmentSource, NULL);
+    glCompileShader(stages[1]);
 
     // if geometry shader source code is given, also compile geometry shader
+    stages[2] = 0;
     if (geometrySource != nullptr) {
-        gShader = glCreateShader(GL_GEOMETRY_SHADER);
-        glShaderSource(gShader, 1, &geometrySource, NULL);
-        glCompileShader(gShader);
-        checkCompileErrors(gShader, "GEOMETRY");
+        stages[2] = glCreateShader(GL_GEOMETRY_SHADER);
+        glShaderSource(stages[2], 1, &geometrySource, NULL);
+        glCompileShader(stages[2]);
     }
 
-    // shader program
+    // shader program (linking is queued right behind the compiles, status is only queried in finishCompile())
     this->ID = glCreateProgram();
-    glAttachShader(this->ID, sVertex);
-    glAttachShader(this->ID, sFragment);
-    if (geometrySource != nullptr)
-        glAttachShader(this->ID, gShader);
+    for (unsigned int stage: stages) {
+        if (stage)
+            glAttachShader(this->ID, stage);
+    }
+
+    // ask the driver to keep the binary around so it can be cached (see getBinary())
+    if (binariesSupported())
+        programBinaryProcs().programParameteri(this->ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
     glLinkProgram(this->ID);
+}
+
+bool Shader::isLinkComplete() const {
+    if (!parallelCompileProcs().maxShaderCompilerThreads)
+        return true;
+    int complete = 0;
+    glGetProgramiv(this->ID, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete != 0;
+}
+
+bool Shader::finishCompile() {
+    const char *types[3] = {"VERTEX", "FRAGMENT", "GEOMETRY"};
+    for (int i = 0; i < 3; i++) {
+        if (stages[i])
+            checkCompileErrors(stages[i], types[i]);
+    }
     checkCompileErrors(this->ID, "PROGRAM");
+    // a program that failed to link stays not ready, so nothing draws with it
+    int linked = 0;
+    glGetProgramiv(this->ID, GL_LINK_STATUS, &linked);
+    if (linked)
+        finishLink();
 
     // delete the shaders as they're linked into our program now and no longer necessary
-    glDeleteShader(sVertex);
-    glDeleteShader(sFragment);
-    if (geometrySource != nullptr)
-        glDeleteShader(gShader);
+    for (unsigned int &stage: stages) {
+        if (stage)
+            glDeleteShader(stage);
+        stage = 0;
+    }
+    return linked != 0;
+}
+
+bool Shader::isReady() const {
+    return ready;
+}
+
+bool Shader::loadBinary(GLenum format, const void *data, int length) {
+    if (!binariesSupported())
+        return false;
+
+    this->ID = glCreateProgram();
+    programBinaryProcs().programBinary(this->ID, format, data, length);
+    int success = 0;
+    glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(this->ID);
+        this->ID = 0;
+        return false;
+    }
+    finishLink();
+    return true;
+}
+
+bool Shader::getBinary(GLenum &format, std::vector<char> &data) const {
+    if (!binariesSupported())
+        return false;
+
+    int length = 0;
+    glGetProgramiv(this->ID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+    data.resize(length);
+    programBinaryProcs().getProgramBinary(this->ID, length, &length, &format, data.data());
+    data.resize(length);
+    return length > 0;
+}
+
+bool Shader::binariesSupported() {
+    return programBinaryProcs().programBinary != nullptr;
+}
+
+void Shader::finishLink() {
+    ready = true;
+    reflectUniforms();
+
+    // point the per-frame uniform block (if this shader declares it) at its shared buffer
+    // (block bindings are not part of a program binary, so this runs after every link)
+    unsigned int frameBlock = glGetUniformBlockIndex(this->ID, FRAME_UNIFORM_BLOCK);
+    if (frameBlock != GL_INVALID_INDEX)
+        glUniformBlockBinding(this->ID, frameBlock, FRAME_UNIFORM_BINDING);
 }
 
 void Shader::setFloat(const char *name, float value) const {
-    glUniform1f(glGetUniformLocation(this->ID, name), value);
+    glUniform1f(location(name), value);
 }
 
 void Shader::setInteger(const char *name, int value) const {
-    glUniform1i(glGetUniformLocation(this->ID, name), value);
+    glUniform1i(location(name), value);
 
 }
 
 void Shader::setVector2f(const char *name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    glUniform2f(location(name), x, y);
 }
 
 void Shader::setVector2f(const char *name, const glm::vec2 &value) const {
-    glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    glUniform2f(location(name), value.x, value.y);
 }
 
 void Shader::setVector3f(const char *name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    glUniform3f(location(name), x, y, z);
 }
 
 void Shader::setVector3f(const char *name, const glm::vec3 &value) const {
-    glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    glUniform3f(location(name), value.x, value.y, value.z);
 }
 
 void Shader::setVector4f(const char *name, float x, float y, float z, float w) const {
-    glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    glUniform4f(location(name), x, y, z, w);
 }
 
 void Shader::setVector4f(const char *name, const glm::vec4 &value) const {
-    glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    glUniform4f(location(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::setMatrix4(const char *name, const glm::mat4 &matrix) const {
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+    glUniformMatrix4fv(location(name), 1, false, glm::value_ptr(matrix));
+}
+
+void Shader::setFloat(Uniform<float> uniform, float value) const {
+    glUniform1f(uniform.location, value);
 }
 
+void Shader::setInteger(Uniform<int> uniform, int value) const {
+    glUniform1i(uniform.location, value);
+}
+
+void Shader::setVector2f(Uniform<glm::vec2> uniform, const glm::vec2 &value) const {
+    glUniform2f(uniform.location, value.x, value.y);
+}
+
+void Shader::setVector3f(Uniform<glm::vec3> uniform, const glm::vec3 &value) const {
+    glUniform3f(uniform.location, value.x, value.y, value.z);
+}
+
+void Shader::setVector4f(Uniform<glm::vec4> uniform, const glm::vec4 &value) const {
+    glUniform4f(uniform.location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::setMatrix4(Uniform<glm::mat4> uniform, const glm::mat4 &matrix) const {
+    glUniformMatrix4fv(uniform.location, 1, false, glm::value_ptr(matrix));
+}
+
+void Shader::reflectUniforms() {
+    uniforms.clear();
+
+    int count = 0, maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(std::max(maxLength, 1));
+
+    for (int i = 0; i < count; i++) {
+        int length = 0, size = 0;
+        GLenum type;
+        glGetActiveUniform(this->ID, i, nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+        string name(nameBuffer.data(), length);
+
+        // uniforms inside blocks have no location
+        int location = glGetUniformLocation(this->ID, name.c_str());
+        if (location < 0)
+            continue;
+
+        // arrays are reported as "name[0]"; make them reachable as "name" too
+        if (size > 1 && name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            name.resize(name.size() - 3);
+
+        uniforms.push_back({fnv1a(name), name, location});
+    }
+
+    std::sort(uniforms.begin(), uniforms.end(),
+              [](const UniformEntry &a, const UniformEntry &b) { return a.hash < b.hash; });
+}
+
+int Shader::location(const char *name) const {
+    uint64_t hash = fnv1a(name, std::strlen(name));
+    auto it = std::lower_bound(uniforms.begin(), uniforms.end(), hash,
+                               [](const UniformEntry &entry, uint64_t h) { return entry.hash < h; });
+    for (; it != uniforms.end() && it->hash == hash; ++it) {
+        if (it->name == name)
+            return it->location;
+    }
+    return -1;
+}
 
 void Shader::checkCompileErrors(unsigned int object, string type) {
     int success;
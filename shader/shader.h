@@ -4,15 +4,25 @@
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 using std::string, std::ifstream, std::stringstream, std::cout, std::endl;
 
 /// @brief General purpose shader object.
 /// @details Compiles from file, generates compile/link-time error messages and hosts several utility functions for easy management.
 class Shader {
     public:
-        /// @brief The shader program ID
-        unsigned int ID;
+        /// @brief The shader program ID (0 until the program is created)
+        unsigned int ID = 0;
+
+        /// @brief Handle to a uniform location, resolved once with uniform()
+        /// @details The template parameter is the GLSL-side value type, so a handle can only be
+        /// passed to the setter that matches it. A location of -1 is silently ignored by OpenGL.
+        template <typename T>
+        struct Uniform {
+            int location = -1;
+        };
 
         /// @brief Construct a new Shader object
         Shader() { }
@@ -29,6 +39,53 @@ class Shader {
         /// @param geometrySource the source code for the geometry shader (optional)
         void compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr); // note: geometry source code is optional
 
+        /// @brief Start compiling and linking without waiting for the driver
+        /// @details With GL_KHR_parallel_shader_compile the driver compiles on its own threads;
+        /// poll isLinkComplete() and call finishCompile() once it returns true. compile() does all three.
+        /// @param vertexSource the source code for the vertex shader
+        /// @param fragmentSource the source code for the fragment shader
+        /// @param geometrySource the source code for the geometry shader (optional)
+        void beginCompile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr);
+
+        /// @brief True once the link started by beginCompile() can be queried without blocking
+        /// @details Always true without GL_KHR_parallel_shader_compile (finishCompile() blocks instead)
+        bool isLinkComplete() const;
+
+        /// @brief Report compile and link errors, delete the shader objects and reflect the program
+        /// @return true if the program linked (otherwise the shader never becomes ready)
+        bool finishCompile();
+
+        /// @brief True once the program is linked and usable
+        /// @details Shaders loaded asynchronously by the ShaderManager start out not ready; draws
+        /// using a shader that isn't ready are skipped.
+        bool isReady() const;
+
+        /// @brief Create the program from a binary previously returned by getBinary()
+        /// @details The driver may reject binaries from another driver version or GPU; nothing is
+        /// printed in that case, the caller is expected to fall back to compile().
+        /// @param format the driver-specific binary format
+        /// @param data the binary
+        /// @param length size of the binary in bytes
+        /// @return true if the program linked from the binary
+        bool loadBinary(GLenum format, const void *data, int length);
+
+        /// @brief Retrieve the linked program as a driver-specific binary
+        /// @param format receives the binary format
+        /// @param data receives the binary
+        /// @return false if program binaries are unsupported or the driver returned none
+        bool getBinary(GLenum &format, std::vector<char> &data) const;
+
+        /// @brief True if the driver supports GL_ARB_get_program_binary with at least one binary format
+        static bool binariesSupported();
+
+        /// @brief Resolve a uniform by name to a typed handle
+        /// @details Looks the name up in the table reflected at link time, so no driver call is made.
+        /// Resolve handles once (e.g. in a constructor) and pass them to the setters every frame.
+        /// @param name name of the uniform
+        /// @return the handle (location -1 if the uniform is not active in this program)
+        template <typename T>
+        Uniform<T> uniform(const char *name) const { return {location(name)}; }
+
         // ------------------------------------------------------------------------
         // utility functions
         // ------------------------------------------------------------------------
@@ -87,7 +144,46 @@ class Shader {
         /// @param useShader boolean to indicate whether to use this shader
         void setMatrix4(const char *name, const glm::mat4 &matrix) const;
 
+        // ------------------------------------------------------------------------
+        // handle based setters (no name lookup at all)
+        // ------------------------------------------------------------------------
+
+        void setFloat(Uniform<float> uniform, float value) const;
+        void setInteger(Uniform<int> uniform, int value) const;
+        void setVector2f(Uniform<glm::vec2> uniform, const glm::vec2 &value) const;
+        void setVector3f(Uniform<glm::vec3> uniform, const glm::vec3 &value) const;
+        void setVector4f(Uniform<glm::vec4> uniform, const glm::vec4 &value) const;
+        void setMatrix4(Uniform<glm::mat4> uniform, const glm::mat4 &matrix) const;
+
     private:
+        /// @brief Set by finishLink()
+        bool ready = false;
+
+        /// @brief Vertex, fragment and geometry shader objects between beginCompile() and finishCompile() (0 if unused)
+        unsigned int stages[3] = {0, 0, 0};
+
+        /// @brief One active uniform of the linked program
+        struct UniformEntry {
+            uint64_t hash;
+            string name;
+            int location;
+        };
+
+        /// @brief Flat table of the active uniforms, sorted by name hash
+        /// @details Filled by reflectUniforms() right after linking
+        std::vector<UniformEntry> uniforms;
+
+        /// @brief Work shared by every way of linking: reflect the uniforms and bind the frame uniform block
+        void finishLink();
+
+        /// @brief Lists the active uniforms with glGetActiveUniform and stores their locations
+        void reflectUniforms();
+
+        /// @brief Hashed lookup of a uniform location in the reflected table
+        /// @param name name of the uniform
+        /// @return the location, or -1 if the program has no active uniform with that name
+        int location(const char *name) const;
+
         /// @brief Checks if compilation or linking failed and if so, print the error logs
         /// @param object the shader object to check
         /// @param type the type of shader object (vertex, fragment, geometry)
@@ -1,7 +1,26 @@
 #include "shaderManager.h"
+#include "../util/hash.h"
+#include "../util/mappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
+namespace {
+    /// @brief First bytes of a cache entry, followed by the binary itself
+    struct ProgramCacheHeader {
+        char     magic[4];
+        uint32_t format;
+        uint64_t key;
+    };
+
+    constexpr char PROGRAM_CACHE_MAGIC[4] = {'G', 'P', 'R', 'G'};
+}
+
+ShaderManager::ShaderManager(AssetLoader *loader, std::string cacheDirectory)
+        : cacheDirectory(std::move(cacheDirectory)), loader(loader) {}
 
 ShaderManager::~ShaderManager() {
     clear();
@@ -11,6 +30,43 @@ Shader ShaderManager::loadShader(const char *vShaderFile, const char *fShaderFil
     return shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
 }
 
+Shader &ShaderManager::loadShaderAsync(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name) {
+    Shader &shader = shaders[name];
+    if (!loader) {
+        shader = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
+        return shader;
+    }
+
+    // the task outlives this call, so it gets its own copies of the paths
+    auto job = std::make_shared<PendingShader>();
+    job->name = name;
+    job->vertexPath = vShaderFile;
+    job->fragmentPath = fShaderFile;
+    job->hasGeometry = gShaderFile != nullptr;
+    if (job->hasGeometry)
+        job->geometryPath = gShaderFile;
+    pending.push_back(job);
+    loader->enqueue([this, job] { return stepLoad(*job); });
+    return shader;
+}
+
+void ShaderManager::update() {
+    for (auto iter = pending.begin(); iter != pending.end();) {
+        if ((*iter)->done.load(std::memory_order_acquire)) {
+            // assign into the existing entry, so references handed out earlier see the program
+            shaders[(*iter)->name] = (*iter)->shader;
+            iter = pending.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+bool ShaderManager::isLoading() const {
+    return !pending.empty();
+}
+
 Shader &ShaderManager::getShader(std::string name) {
     return shaders[name];
 }
@@ -27,6 +83,25 @@ Shader ShaderManager::loadShaderFromFile(const char *vShaderFile, const char *fS
     std::string vertexCode;
     std::string fragmentCode;
     std::string geometryCode;
+    readSources(vShaderFile, fShaderFile, gShaderFile, vertexCode, fragmentCode, geometryCode);
+    const char *vShaderCode = vertexCode.c_str();
+    const char *fShaderCode = fragmentCode.c_str();
+    const char *gShaderCode = geometryCode.c_str();
+    // 2. warm start: link straight from the cached driver binary
+    Shader shader;
+    uint64_t key = programKey(vertexCode, fragmentCode, geometryCode);
+    if (Shader::binariesSupported() && loadCachedProgram(key, shader))
+        return shader;
+
+    // 3. otherwise create shader object from source code, and cache it for next time
+    shader.compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
+    if (shader.isReady() && Shader::binariesSupported())
+        storeCachedProgram(key, shader);
+    return shader;
+}
+
+void ShaderManager::readSources(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile,
+                                std::string &vertexCode, std::string &fragmentCode, std::string &geometryCode) {
     try {
         // open files
         std::ifstream vertexShaderFile(vShaderFile);
@@ -53,11 +128,96 @@ Shader ShaderManager::loadShaderFromFile(const char *vShaderFile, const char *fS
     catch (std::exception &e) {
         std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
     }
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
-    const char *gShaderCode = geometryCode.c_str();
-    // 2. now create shader object from source code
-    Shader shader;
-    shader.compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
-    return shader;
+}
+
+bool ShaderManager::stepLoad(PendingShader &job) const {
+    if (!job.compiling) {
+        // first step: file I/O, then the binary cache, then start the compile and come back later
+        readSources(job.vertexPath.c_str(), job.fragmentPath.c_str(), job.hasGeometry ? job.geometryPath.c_str() : nullptr,
+                    job.vertexCode, job.fragmentCode, job.geometryCode);
+        job.key = programKey(job.vertexCode, job.fragmentCode, job.geometryCode);
+        if (Shader::binariesSupported() && loadCachedProgram(job.key, job.shader)) {
+            glFinish();
+            job.done.store(true, std::memory_order_release);
+            return true;
+        }
+        job.shader.beginCompile(job.vertexCode.c_str(), job.fragmentCode.c_str(),
+                                job.hasGeometry ? job.geometryCode.c_str() : nullptr);
+        job.compiling = true;
+        return false;
+    }
+
+    if (!job.shader.isLinkComplete())
+        return false;
+    // a program that failed to link is not cached, so the next run compiles (and reports) it again
+    if (job.shader.finishCompile() && Shader::binariesSupported())
+        storeCachedProgram(job.key, job.shader);
+
+    // the program is used from the main context, so it has to be complete before it is published
+    glFinish();
+    job.done.store(true, std::memory_order_release);
+    return true;
+}
+
+uint64_t ShaderManager::programKey(const std::string &vertexCode, const std::string &fragmentCode, const std::string &geometryCode) {
+    // hash the length of each part too, so moving text from one stage to the next changes the key
+    uint64_t hash = fnv1a(std::to_string(vertexCode.size()) + ":" + vertexCode);
+    hash = fnv1a(std::to_string(fragmentCode.size()) + ":" + fragmentCode, hash);
+    hash = fnv1a(std::to_string(geometryCode.size()) + ":" + geometryCode, hash);
+
+    // a binary is only valid for the driver that produced it
+    for (GLenum name: {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const char *value = reinterpret_cast<const char *>(glGetString(name));
+        hash = fnv1a(value ? value : "", hash);
+        hash = fnv1a("\n", 1, hash);
+    }
+    return hash;
+}
+
+std::string ShaderManager::cachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return cacheDirectory + "/" + name;
+}
+
+bool ShaderManager::loadCachedProgram(uint64_t key, Shader &shader) const {
+    MappedFile file(cachePath(key));
+    if (!file.isOpen() || file.size() <= sizeof(ProgramCacheHeader))
+        return false;
+
+    ProgramCacheHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC)) != 0 || header.key != key)
+        return false;
+
+    // the driver may still refuse it (e.g. after an update that kept the version string)
+    return shader.loadBinary(header.format, file.data() + sizeof(header), static_cast<int>(file.size() - sizeof(header)));
+}
+
+void ShaderManager::storeCachedProgram(uint64_t key, const Shader &shader) const {
+    ProgramCacheHeader header{};
+    std::vector<char> binary;
+    GLenum format = 0;
+    if (!shader.getBinary(format, binary))
+        return;
+    std::memcpy(header.magic, PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC));
+    header.format = format;
+    header.key = key;
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+
+    // write to a temporary name and rename, so a crash never leaves a truncated entry behind
+    std::string path = cachePath(key);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(binary.data(), binary.size());
+        if (!file) {
+            std::cout << "| WARNING::SHADER: could not write program cache " << path << std::endl;
+            return;
+        }
+    }
+    std::rename(temporary.c_str(), path.c_str());
 }
\ No newline at end of file
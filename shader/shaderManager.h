@@ -2,14 +2,29 @@
 #define GRAPHICS_SHADERMANAGER_H
 
 #include "shader.h"
+#include "../renderer/assetLoader.h"
 
+#include <atomic>
+#include <cstdint>
+#include <list>
 #include <map>
+#include <memory>
 #include <iostream>
 
+/// @brief Loads, stores and hands out the shaders by name
+/// @details Linked programs are cached on disk as driver binaries (GL_ARB_get_program_binary), keyed
+/// by a hash of the shader sources and the GL vendor, renderer and version strings. A warm start loads
+/// the binary with glProgramBinary and skips the GLSL compiler; a missing or rejected binary falls
+/// back to compiling and rewrites the cache entry.
+///
+/// With an AssetLoader, loadShaderAsync() reads, compiles and links on the loader thread and returns
+/// at once; update() publishes finished programs into the references getShader() handed out.
 class ShaderManager {
 public:
-    /// @brief Default constructor
-    ShaderManager() = default;
+    /// @brief Constructor
+    /// @param loader Runs asynchronous loads (nullptr to load everything synchronously)
+    /// @param cacheDirectory Where program binaries are kept (created on first write)
+    explicit ShaderManager(AssetLoader *loader = nullptr, std::string cacheDirectory = "shader_cache");
     /// @brief Default destructor
     /// @details Clears the shaders map
     ~ShaderManager();
@@ -23,6 +38,24 @@ public:
     /// @return The shader that was loaded
     Shader loadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name);
 
+    /// @brief Starts loading a shader on the loader thread and returns its entry in the shaders map
+    /// @details The reference stays valid and becomes ready (Shader::isReady()) in the update() after
+    /// the program is linked. Compiles use GL_KHR_parallel_shader_compile where available, so several
+    /// shaders queued together are compiled by the driver at the same time.
+    /// @param vShaderFile The vertex shader file
+    /// @param fShaderFile The fragment shader file
+    /// @param gShaderFile The geometry shader file (optional)
+    /// @param name Name used for the shader in the shaders map
+    /// @return The shader entry, not ready yet
+    Shader& loadShaderAsync(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name);
+
+    /// @brief Publishes the shaders that finished loading since the last call
+    /// @details Call once per frame on the render thread, which owns the GL context (see Engine::render)
+    void update();
+
+    /// @brief True while asynchronous loads are still in flight (render thread only, like update())
+    bool isLoading() const;
+
     /// @brief Returns a reference to the shader with the given name in the shaders map
     /// @param name The name of the shader
     /// @return The shader with the given name
@@ -35,12 +68,58 @@ private:
     /// @brief A map of shaders, with the key being the name of the shader
     std::map<std::string, Shader> shaders;
 
+    /// @brief Directory of the program binary cache
+    std::string cacheDirectory;
+
+    /// @brief Runs the asynchronous loads, nullptr if everything loads synchronously
+    AssetLoader *loader;
+
+    /// @brief An asynchronous load, shared by the loader task and update()
+    struct PendingShader {
+        std::string name;
+        std::string vertexPath, fragmentPath, geometryPath;
+        bool hasGeometry = false;
+        /// @brief Sources, kept alive while the driver compiles them
+        std::string vertexCode, fragmentCode, geometryCode;
+        uint64_t key = 0;
+        bool compiling = false;
+        /// @brief Built on the loader thread, copied into the map by update()
+        Shader shader;
+        /// @brief Set (release) by the loader thread once shader may be read
+        std::atomic<bool> done{false};
+    };
+
+    /// @brief Loads not yet published by update() (render thread only)
+    std::list<std::shared_ptr<PendingShader>> pending;
+
+    /// @brief Reads the three source files (the geometry one only if the path is not null)
+    static void readSources(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile,
+                            std::string &vertexCode, std::string &fragmentCode, std::string &geometryCode);
+
+    /// @brief One step of an asynchronous load on the loader thread
+    /// @return true once the load is done
+    bool stepLoad(PendingShader &job) const;
+
      /// @brief Loads and compiles a shader from a file
      /// @details This function is private because we only want to load shaders from within this class
      /// @param vShaderFile The vertex shader file
      /// @param fShaderFile The fragment shader file
      /// @param gShaderFile The geometry shader file (optional)
      /// @return The shader that was loaded
-    Shader loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile=nullptr);};
+    Shader loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile=nullptr);
+
+    /// @brief Hash identifying a program: its sources plus the driver that compiled it
+    static uint64_t programKey(const std::string &vertexCode, const std::string &fragmentCode, const std::string &geometryCode);
+
+    /// @brief Path of the cache entry for a program key
+    std::string cachePath(uint64_t key) const;
+
+    /// @brief Links shader from its cached binary
+    /// @return false if there is no entry or the driver rejects it
+    bool loadCachedProgram(uint64_t key, Shader &shader) const;
+
+    /// @brief Writes the binary of a freshly compiled shader to the cache
+    void storeCachedProgram(uint64_t key, const Shader &shader) const;
+};
 
 #endif //GRAPHICS_SHADERMANAGER_H
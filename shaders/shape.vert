@@ -3,9 +3,15 @@
 layout (location = 0) in vec2 aPos;
 
 uniform mat4 model;
-uniform mat4 projection;
+
+layout (std140) uniform Frame {
+    mat4 projection;
+    mat4 view;
+    vec4 viewport;
+    float time;
+};
 
 void main()
 {
-    gl_Position = projection * model * vec4(aPos.x, aPos.y, 0.0, 1.0);
+    gl_Position = projection * view * model * vec4(aPos.x, aPos.y, 0.0, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#version 330 core
+
+in vec2 vLocal;
+in float vRadius;
+in vec4 vColor;
+out vec4 FragColor;
+
+// 0 = disc, 1 = ring, 2 = outline (matches TargetStyle)
+uniform int style;
+
+void main()
+{
+    // signed distance to the shape's edge in pixels, negative inside
+    float r = length(vLocal);
+    float dist;
+    if (style == 1)
+        dist = abs(r - 0.8 * vRadius) - 0.2 * vRadius;
+    else if (style == 2)
+        dist = abs(r - (vRadius - 1.5)) - 1.5;
+    else
+        dist = r - vRadius;
+
+    // one pixel wide screen-space ramp across the edge
+    float coverage = clamp(0.5 - dist / max(fwidth(dist), 1e-4), 0.0, 1.0);
+    if (coverage <= 0.0)
+        discard;
+    FragColor = vec4(vColor.rgb, vColor.a * coverage);
+}
@@ -0,0 +1,28 @@
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+// per-instance attributes (advance once per target, see glVertexAttribDivisor)
+layout (location = 1) in vec2 aOffset;
+layout (location = 2) in vec2 aSize;
+layout (location = 3) in vec4 aColor;
+
+layout (std140) uniform Frame {
+    mat4 projection;
+    mat4 view;
+    vec4 viewport;
+    float time;
+};
+
+out vec2 vLocal;     // position inside the target in pixels, relative to its center
+out float vRadius;   // radius of the target in pixels
+out vec4 vColor;
+
+void main()
+{
+    // grow the quad by a pixel on every side so the anti-aliased edge isn't clipped
+    vec2 padded = aSize + 2.0;
+    vLocal = aPos * padded;
+    vRadius = aSize.x * 0.5;
+    vColor = aColor;
+    gl_Position = projection * view * vec4(aOffset + vLocal, 0.0, 1.0);
+}
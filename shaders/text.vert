@@ -1,11 +1,19 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 1) in vec4 color;
 out vec2 TexCoords;
+out vec4 TextColor;
 
-uniform mat4 projection;
+layout (std140) uniform Frame {
+    mat4 projection;
+    mat4 view;
+    vec4 viewport;
+    float time;
+};
 
 void main()
 {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    TextColor = color;
 }  
\ No newline at end of file
@@ -4,68 +4,26 @@
 
 #include "circle.h"
 #include "../util/color.h"
-#include <cmath>
 
-//constructors
+//constructors. The mesh for this segment count is shared through the MeshRegistry
 Circle::Circle(Shader &shader, vec2 pos, vec2 size, struct color color, int segments)
     : Shape(shader, pos, size, color), segments(segments)
 {
-    initVectors();
-    initVAO();
-    initVBO();
-    initEBO();
+    mesh = &MeshRegistry::instance().acquire(MeshKind::Circle, this->segments);
 }
 
 
 Circle::Circle(const Circle &other)
-    : Shape(other), segments(other.segments)
-{
-    initVectors();
-    initVAO();
-    initVBO();
-    initEBO();
-}
+    : Shape(other), segments(other.segments) {}
 
 //destructor
-Circle::~Circle() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-}
-
-void Circle::initVectors() {
-    //clear all the data, then create the origin
-    vertices.clear();
-    indices.clear();
-    vertices.push_back(0.0f);  // x
-    vertices.push_back(0.0f);  // y
-
-    //using the segments and pi for angles
-    float angleStep = 2.0f * PI / segments;
-
+Circle::~Circle() {}
 
-    //get vertices from the circumference. r = 0.5, so we fit inside the original recrtangle
-    for (int i = 0; i <= segments; i++) {
-        float angle = i * angleStep;
-        float x = 0.5f * cos(angle);
-        float y = 0.5f * sin(angle);
-        vertices.push_back(x);
-        vertices.push_back(y);
-    }
-    for (int i = 1; i <= segments; i++) {
-        //vertex/center
-        indices.push_back(0);
-        //vertex of current segment or circumference
-        indices.push_back(i);
-        //vertex of next circumference vertex
-        indices.push_back(i + 1);
-    }
+void Circle::draw() const {
+    glBindVertexArray(mesh->VAO);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh->indexCount), GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
 }
-    void Circle::draw() const {
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-    }
 
 //getters for finding the edges
 float Circle::getLeft() const {
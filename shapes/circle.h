@@ -12,9 +12,7 @@ using glm::vec2, glm::vec3;
 
 class Circle : public Shape {
 private:
-    void initVectors();
-    //variables to represent PI and being marked for removal
-    float PI = 3.14159;
+    //variable to represent being marked for removal
     bool removeMe = false;
 public:
     //the constructor for a Circle, with a default int of 42 segements representing pieces of the circle
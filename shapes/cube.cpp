@@ -22,7 +22,7 @@ Cube::~Cube() {
     glDeleteBuffers(1, &EBO);
 }
 
-void Cube::setUniforms(const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection) const {
+void Cube::setUniforms(const glm::mat4 &model) const {
     glm::mat4 modelMatrix = model;
     // The model matrix is used to transform the vertices of the shape in relation to the world space.
     modelMatrix = translate(modelMatrix, vec3(pos));
@@ -34,8 +34,6 @@ void Cube::setUniforms(const glm::mat4 &model, const glm::mat4 &view, const glm:
     // The size of the shape is scaled by the model matrix to make the shape larger or smaller.
     modelMatrix = scale(modelMatrix, vec3(size));
     this->shader.setMatrix4("model", modelMatrix);
-    this->shader.setMatrix4("view", view);
-    this->shader.setMatrix4("projection", projection);
 }
 
 void Cube::rotateX(float delta) {
@@ -56,7 +54,7 @@ void Cube::changeSize(float delta) {
     size[2] += delta;
 }
 
-void Cube::draw(const mat4& model, const mat4& view, const mat4& projection) const {
+void Cube::draw() const {
     glBindVertexArray(this->VAO);
     glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
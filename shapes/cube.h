@@ -15,8 +15,9 @@ class Cube {
 public:
     Cube(Shader& shader, vec3 pos, vec3 size, vector<color> colors);
     ~Cube();
-    void draw(const mat4& model, const mat4& view, const mat4& projection) const;
-    void setUniforms(const mat4& model, const mat4& view, const mat4& projection) const;
+    void draw() const;
+    /// @brief Sets the model matrix; view and projection come from the per-frame uniform block
+    void setUniforms(const mat4& model) const;
 
     void rotateX(float delta);
     void rotateY(float delta);
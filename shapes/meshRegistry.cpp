@@ -0,0 +1,94 @@
+#include "meshRegistry.h"
+
+#include <glad/glad.h>
+#include <cmath>
+
+MeshRegistry &MeshRegistry::instance() {
+    static MeshRegistry registry;
+    return registry;
+}
+
+MeshRegistry::~MeshRegistry() {
+    clear();
+}
+
+const Mesh &MeshRegistry::acquire(MeshKind kind, unsigned int segments) {
+    // only circles are tessellated, so every rect shares the same key
+    if (kind != MeshKind::Circle)
+        segments = 0;
+
+    auto key = std::make_pair(kind, segments);
+    auto found = meshes.find(key);
+    if (found != meshes.end())
+        return found->second;
+
+    // the vectors only live until they have been uploaded
+    vector<float> vertices;
+    vector<unsigned int> indices;
+    buildVectors(kind, segments, vertices, indices);
+    return meshes[key] = upload(vertices, indices);
+}
+
+void MeshRegistry::clear() {
+    for (const auto &iter: meshes) {
+        glDeleteVertexArrays(1, &iter.second.VAO);
+        glDeleteBuffers(1, &iter.second.VBO);
+        glDeleteBuffers(1, &iter.second.EBO);
+    }
+    meshes.clear();
+}
+
+void MeshRegistry::buildVectors(MeshKind kind, unsigned int segments, vector<float> &vertices, vector<unsigned int> &indices) {
+    switch (kind) {
+        case MeshKind::Rect:
+            vertices = {
+                    0.5f, -0.5f,  // x, y of bottom right corner
+                    -0.5f, -0.5f, // xy of bottom left
+                    -0.5f, 0.5f,  // xy of top left
+                    0.5f, 0.5f    // xy of top right
+            };
+            indices = {
+                    0, 1, 2, // First triangle
+                    1, 2, 3  // Second triangle
+            };
+            break;
+        case MeshKind::Circle: {
+            // origin, then points on the circumference. r = 0.5, so we fit inside the unit rectangle
+            vertices = {0.0f, 0.0f};
+            float angleStep = 2.0f * 3.14159f / segments;
+            for (unsigned int i = 0; i <= segments; i++) {
+                vertices.push_back(0.5f * cos(i * angleStep));
+                vertices.push_back(0.5f * sin(i * angleStep));
+            }
+            // one triangle per segment: center, current and next circumference vertex
+            for (unsigned int i = 1; i <= segments; i++) {
+                indices.insert(indices.end(), {0, i, i + 1});
+            }
+            break;
+        }
+    }
+}
+
+Mesh MeshRegistry::upload(const vector<float> &vertices, const vector<unsigned int> &indices) {
+    Mesh mesh{};
+    mesh.indexCount = indices.size();
+
+    glGenVertexArrays(1, &mesh.VAO);
+    glBindVertexArray(mesh.VAO);
+
+    glGenBuffers(1, &mesh.VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    // 2 floats per vertex (x, y)
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glGenBuffers(1, &mesh.EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    // unbind the VAO first so it keeps the EBO binding
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return mesh;
+}
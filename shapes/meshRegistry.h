@@ -0,0 +1,58 @@
+#ifndef GRAPHICS_MESHREGISTRY_H
+#define GRAPHICS_MESHREGISTRY_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+using std::vector;
+
+/// @brief The kinds of unit meshes shapes can be built from
+enum class MeshKind { Rect, Circle };
+
+/// @brief GPU handles of a mesh uploaded by the MeshRegistry
+struct Mesh {
+    /// @brief The Vertex Array Object, Vertex Buffer Object, and Element Buffer Object of the mesh.
+    unsigned int VAO, VBO, EBO;
+    /// @brief Number of indices to draw
+    unsigned int indexCount;
+};
+
+/**
+ * @brief Uploads each unique shape mesh once and hands out shared handles
+ * @details Meshes are keyed by kind and segment count. The vertex and index arrays are only
+ * built long enough to upload them, so no CPU-side copy is kept, and constructing or copying
+ * a shape that uses an already uploaded mesh costs no GL allocations.
+ */
+class MeshRegistry {
+public:
+    /// @brief Returns the registry shared by all shapes
+    static MeshRegistry& instance();
+
+    /// @brief Deletes all meshes
+    ~MeshRegistry();
+
+    /// @brief Returns the mesh of the given kind, uploading it on first use
+    /// @param kind The kind of mesh
+    /// @param segments The number of segments (only used for circles)
+    /// @return The shared mesh handles
+    const Mesh& acquire(MeshKind kind, unsigned int segments = 0);
+
+    /// @brief Deletes every uploaded mesh
+    /// @details Handles returned by acquire() are invalid afterwards
+    void clear();
+
+private:
+    MeshRegistry() = default;
+
+    /// @brief A map of meshes, keyed by kind and segment count
+    std::map<std::pair<MeshKind, unsigned int>, Mesh> meshes;
+
+    /// @brief Builds the vertices (x, y pairs) and indices of a unit mesh
+    static void buildVectors(MeshKind kind, unsigned int segments, vector<float>& vertices, vector<unsigned int>& indices);
+
+    /// @brief Uploads the vertices and indices into a new VAO/VBO/EBO
+    static Mesh upload(const vector<float>& vertices, const vector<unsigned int>& indices);
+};
+
+#endif //GRAPHICS_MESHREGISTRY_H
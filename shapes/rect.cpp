@@ -3,47 +3,19 @@
 
 Rect::Rect(Shader & shader, vec2 pos, vec2 size, struct color color)
         : Shape(shader, pos, size, color) {
-    initVectors();
-    initVAO();
-    initVBO();
-    initEBO();
+    mesh = &MeshRegistry::instance().acquire(MeshKind::Rect);
 }
 
-Rect::Rect(Rect const& other) : Shape(other) {
-    initVectors();
-    initVAO();
-    initVBO();
-    initEBO();
-}
+Rect::Rect(Rect const& other) : Shape(other) {}
 
-Rect::~Rect() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-}
+Rect::~Rect() {}
 
 void Rect::draw() const {
-    glBindVertexArray(VAO);
+    glBindVertexArray(mesh->VAO);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 }
 
-void Rect::initVectors() {
-    this->vertices.insert(vertices.end(), {
-            // TODO: Add other three corners here
-            // Note: the order of the corners matters because the two triangles
-            //    formed below from the indices of these corners must fill the 
-            //    rectangle
-            0.5f, -0.5f,  // x, y of bottom right corner
-            -0.5f, -0.5, //xy of bottom left
-            -0.5f, 0.5f, //xy of top left
-            0.5, 0.5 // xy of top right
-    });
-
-    this->indices.insert(indices.end(), {
-            0, 1, 2, // First triangle
-            1, 2, 3  // Second triangle
-    });
-}
 // Overridden Getters from Shape
 float Rect::getLeft() const {
     return pos.x - (size.x / 2.0f);
@@ -8,12 +8,9 @@ using glm::vec2, glm::vec3;
 
 
 class Rect : public Shape {
-private:
-    /// @brief Initializes the vertices and indices of the square
-    void initVectors();
 public:
     /// @brief Construct a new Square object
-    /// @details This constructor will call the InitRenderData function.
+    /// @details The unit rect mesh is shared through the MeshRegistry.
     /// @param shader The shader to use
     /// @param pos The position of the square
     /// @param size The size of the square
@@ -22,7 +19,7 @@ public:
 
     Rect(Rect const& other);
 
-    /// @brief Destroy the Square object and delete it's VAO and VBO
+    /// @brief Destroy the Square object (the shared mesh stays in the registry)
     ~Rect();
 
     /// @brief Binds the VAO and calls the virtual draw function
@@ -1,37 +1,20 @@
  #include "shape.h"
 
 Shape::Shape(Shader &shader, glm::vec2 pos, glm::vec2 size, struct color color) :
-        shader(shader), pos(pos), size(size), color(color) {}
-
-Shape::Shape(Shape const& other) :
-        shader(other.shader), pos(other.pos), size(other.size), color(other.color) {}
-
-// Initialize VAO
-unsigned int Shape::initVAO() {
-    glGenVertexArrays(1, &VAO); // Generate VAO
-    glBindVertexArray(VAO); // Bind VAO
-    return VAO;
+        shader(shader), pos(pos), size(size), color(color) {
+    resolveUniforms();
 }
 
-// Initialize VBO
-void Shape::initVBO() {
-    // Generate VBO, bind it to VAO, and copy vertices data into it
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    // Set the vertex attribute pointers (2 floats per vertex (x, y))
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0); // Enable the vertex attribute at location 0
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind VBO
-}
-
-// Initialize EBO
-void Shape::initEBO() {
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(float), indices.data(), GL_STATIC_DRAW);
-    // Don't unbind EBO because it's bound to VAO
+Shape::Shape(Shape const& other) :
+        shader(other.shader), pos(other.pos), size(other.size), color(other.color), mesh(other.mesh),
+        modelUniform(other.modelUniform), colorUniform(other.colorUniform), uniformsResolved(other.uniformsResolved) {}
+
+void Shape::resolveUniforms() const {
+    if (uniformsResolved || !shader.isReady())
+        return;
+    modelUniform = shader.uniform<mat4>("model");
+    colorUniform = shader.uniform<vec4>("shapeColor");
+    uniformsResolved = true;
 }
 
 void Shape::setUniforms() const {
@@ -47,8 +30,25 @@ void Shape::setUniforms() const {
     model = scale(model, vec3(size, 1.0f));
 
     // Set the model matrix and color uniform variables in the shader
-    this->shader.setMatrix4("model", model);
-    this->shader.setVector4f("shapeColor", color.vec);
+    resolveUniforms();
+    this->shader.setMatrix4(modelUniform, model);
+    this->shader.setVector4f(colorUniform, color.vec);
+}
+
+void Shape::submit(RenderQueue &queue, RenderLayer layer) const {
+    resolveUniforms();
+    RenderCommand command;
+    command.layer = layer;
+    command.shader = &shader;
+    command.VAO = mesh->VAO;
+    command.indexed = true;
+    command.count = static_cast<int>(mesh->indexCount);
+    // same model matrix as setUniforms()
+    command.modelUniform = modelUniform;
+    command.model = scale(translate(mat4(1.0f), vec3(pos, 1.0f)), vec3(size, 1.0f));
+    command.colorUniform = colorUniform;
+    command.color = color.vec;
+    queue.submit(command);
 }
 
 bool Shape::isOverlapping(const vec2 &point) const {
@@ -5,6 +5,8 @@
 #include <vector>
 #include "../shader/shader.h"
 #include "../util/color.h"
+#include "meshRegistry.h"
+#include "../renderer/renderQueue.h"
 
 using std::vector, glm::vec2, glm::vec3, glm::vec4, glm::mat4, glm::translate, glm::scale;
 
@@ -23,23 +25,6 @@ public:
     /// @brief Destroy the Shape object
     virtual ~Shape() = default;
 
-    // --------------------------------------------------------
-    // Initialization functions
-    // --------------------------------------------------------
-
-    /// @brief Initializes the VAO.
-    /// @details This function is called in the derived classes' constructor.
-    unsigned int initVAO();
-
-    /// @brief Initializes the VBO.
-    /// @details This function is called in the derived classes' constructor.
-    void initVBO();
-
-    /// @brief Initializes the EBO.
-    /// @details This function is called in the derived classes' constructor.
-    /// @details If function has no indices, pass nullptr for indices and 0 for indexCount.
-    void initEBO();
-
     // --------------------------------------------------------
     // Getters
     // --------------------------------------------------------
@@ -118,6 +103,11 @@ public:
     /// @brief Pure virtual function to draw the shape.
     virtual void draw() const = 0;
 
+    /// @brief Records the shape (mesh, model matrix and color) into a render queue instead of drawing it now
+    /// @param queue The queue to record into
+    /// @param layer The layer to draw the shape in
+    void submit(RenderQueue& queue, RenderLayer layer) const;
+
 protected:
     /// @brief Shader used to draw all abstract shapes.
     /// @note This will need to be a pointer for custom shaders.
@@ -132,14 +122,19 @@ protected:
     /// @brief The VAO of the shape
     color color;
 
-    /// @brief The Vertex Array Object, Vertex Buffer Object, and Element Buffer Object of the shape.
-    unsigned int VAO, VBO, EBO;
+    /// @brief The mesh of the shape, shared with every other shape of the same kind.
+    /// @details Set in the derived classes' constructor from the MeshRegistry.
+    const Mesh* mesh = nullptr;
 
-    /// @brief The vertices of the shape
-    vector<float> vertices;
+    /// @brief Uniform handles of the shader, resolved once the shader is ready
+    /// @details The shader may still be loading when the shape is constructed, so the handles are
+    /// resolved on first use after that (see resolveUniforms()).
+    mutable Shader::Uniform<mat4> modelUniform;
+    mutable Shader::Uniform<vec4> colorUniform;
+    mutable bool uniformsResolved = false;
 
-    /// @brief The indices of the shape
-    vector<unsigned int> indices;
+    /// @brief Resolves the uniform handles if the shader has become ready
+    void resolveUniforms() const;
 };
 
 #endif //GRAPHICS_SHAPE_H
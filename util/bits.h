@@ -0,0 +1,30 @@
+#ifndef GRAPHICS_BITS_H
+#define GRAPHICS_BITS_H
+
+#include <cstdint>
+
+#if defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__cpp_lib_bitops)
+#include <intrin.h>
+#endif
+
+/// @brief Index of the lowest set bit of a mask (the mask must not be 0)
+/// @details std::countr_zero where the standard library has it, otherwise the compiler's intrinsic
+inline unsigned int lowestBit(uint64_t bits) {
+#if defined(__cpp_lib_bitops)
+    return static_cast<unsigned int>(std::countr_zero(bits));
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(bits));
+#endif
+}
+
+#endif //GRAPHICS_BITS_H
@@ -0,0 +1,114 @@
+#include "framePacer.h"
+
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace {
+    /// @brief How much earlier than the deadline the sleep ends; the rest is spun.
+    /// Covers the usual timer slack and scheduler wake-up latency (larger on macOS, whose
+    /// sleeps are coalesced more aggressively).
+#ifdef __APPLE__
+    constexpr std::chrono::microseconds SPIN_MARGIN(2000);
+#else
+    constexpr std::chrono::microseconds SPIN_MARGIN(1000);
+#endif
+}
+
+FramePacer::FramePacer(PacingMode mode, double fps) {
+    setMode(mode, fps);
+}
+
+void FramePacer::apply() const {
+    glfwSwapInterval(mode == PacingMode::VSync ? 1 : 0);
+}
+
+void FramePacer::setMode(PacingMode mode, double fps) {
+    // a cap that isn't a positive rate means no cap
+    if (mode == PacingMode::Capped && !(fps > 0.0))
+        mode = PacingMode::Uncapped;
+    this->mode = mode;
+    if (mode == PacingMode::Capped)
+        period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    deadline = Clock::time_point{};
+    resetStats();
+}
+
+PacingMode FramePacer::getMode() const {
+    return mode;
+}
+
+void FramePacer::pace() {
+    if (mode == PacingMode::Capped) {
+        Clock::time_point now = Clock::now();
+        // first frame, or more than a whole period behind (a hitch): restart the schedule from now
+        // rather than rushing frames out to catch up
+        if (deadline == Clock::time_point{} || now - deadline > period)
+            deadline = now;
+        else
+            waitUntil(deadline);
+        deadline += period;
+    }
+
+    Clock::time_point now = Clock::now();
+    if (lastFrame != Clock::time_point{})
+        record(std::chrono::duration<double, std::milli>(now - lastFrame).count());
+    lastFrame = now;
+}
+
+FramePacer::Stats FramePacer::getStats() const {
+    Stats stats;
+    stats.frames = frames;
+    stats.mean = mean;
+    stats.jitter = frames > 1 ? std::sqrt(m2 / (frames - 1)) : 0.0;
+    stats.min = min;
+    stats.max = max;
+    return stats;
+}
+
+void FramePacer::resetStats() {
+    frames = 0;
+    mean = m2 = min = max = 0.0;
+    lastFrame = Clock::time_point{};
+}
+
+void FramePacer::waitUntil(Clock::time_point target) const {
+    Clock::time_point wake = target - SPIN_MARGIN;
+    Clock::time_point now = Clock::now();
+    if (wake > now) {
+#ifdef __linux__
+        // absolute CLOCK_MONOTONIC deadline, so being preempted before the call doesn't lengthen the sleep
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        long long nanoseconds = ts.tv_nsec + std::chrono::duration_cast<std::chrono::nanoseconds>(wake - now).count();
+        ts.tv_sec += nanoseconds / 1000000000;
+        ts.tv_nsec = nanoseconds % 1000000000;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {} // restart if interrupted by a signal
+#else
+        std::this_thread::sleep_until(wake);
+#endif
+    }
+
+    while (Clock::now() < target)
+        std::this_thread::yield();
+}
+
+void FramePacer::record(double milliseconds) {
+    frames++;
+    if (frames == 1) {
+        min = max = milliseconds;
+    }
+    else {
+        min = std::min(min, milliseconds);
+        max = std::max(max, milliseconds);
+    }
+    double delta = milliseconds - mean;
+    mean += delta / frames;
+    m2 += delta * (milliseconds - mean);
+}
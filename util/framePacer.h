@@ -0,0 +1,100 @@
+#ifndef GRAPHICS_FRAMEPACER_H
+#define GRAPHICS_FRAMEPACER_H
+
+#include <chrono>
+#include <cstddef>
+
+/// @brief How the frame rate is limited
+enum class PacingMode {
+    /// @brief Swap interval 1: the display's refresh paces the frames
+    VSync,
+    /// @brief Swap interval 0, no limit
+    Uncapped,
+    /// @brief Swap interval 0, frames released at a fixed rate by FramePacer::pace()
+    Capped
+};
+
+/**
+ * @brief Limits and measures the frame rate
+ * @details In Capped mode each frame is released at an absolute deadline one period after the
+ * previous one, so errors don't accumulate. Waiting is hybrid: the thread sleeps until shortly before
+ * the deadline (clock_nanosleep with TIMER_ABSTIME on Linux, sleep_until elsewhere) and spins for the
+ * rest, which keeps the release jitter well under 100 us without burning a core for the whole frame.
+ *
+ * In every mode the interval between successive pace() calls is recorded, see getStats().
+ */
+class FramePacer {
+    public:
+        /// @brief Frame interval statistics since the last resetStats(), in milliseconds
+        struct Stats {
+            size_t frames = 0;
+            double mean = 0.0;
+            /// @brief Standard deviation of the interval
+            double jitter = 0.0;
+            double min = 0.0;
+            double max = 0.0;
+        };
+
+        /**
+         * @brief Construct a new Frame Pacer object
+         *
+         * @param mode The pacing mode
+         * @param fps The frame rate cap (only used in Capped mode)
+         */
+        FramePacer(PacingMode mode = PacingMode::VSync, double fps = 0.0);
+
+        /**
+         * @brief Sets the swap interval the mode needs on the current context
+         * @details Call once the window's context is current, and after changing the mode
+         */
+        void apply() const;
+
+        /**
+         * @brief Changes the pacing mode (call apply() afterwards)
+         *
+         * @param mode The pacing mode
+         * @param fps The frame rate cap (only used in Capped mode)
+         */
+        void setMode(PacingMode mode, double fps = 0.0);
+
+        /// @brief The current pacing mode
+        PacingMode getMode() const;
+
+        /**
+         * @brief Waits for this frame's deadline (Capped mode only) and records the frame interval
+         * @details Call once per frame, right before swapping buffers
+         */
+        void pace();
+
+        /// @brief The frame interval statistics
+        Stats getStats() const;
+
+        /// @brief Starts collecting statistics from scratch
+        void resetStats();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        PacingMode mode;
+
+        /// @brief Target frame interval in Capped mode
+        Clock::duration period{};
+
+        /// @brief When the next frame is due in Capped mode
+        Clock::time_point deadline{};
+
+        /// @brief When the last frame was released, for the interval statistics
+        Clock::time_point lastFrame{};
+
+        /// @brief Running interval statistics (Welford's algorithm; m2 is the sum of squared deviations)
+        size_t frames = 0;
+        double mean = 0.0, m2 = 0.0, min = 0.0, max = 0.0;
+
+        /// @brief Sleeps until shortly before the deadline, then spins until it
+        void waitUntil(Clock::time_point target) const;
+
+        /// @brief Adds one frame interval to the statistics
+        void record(double milliseconds);
+};
+
+#endif //GRAPHICS_FRAMEPACER_H
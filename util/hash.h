@@ -0,0 +1,25 @@
+#ifndef GRAPHICS_HASH_H
+#define GRAPHICS_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief 64-bit FNV-1a hash of a block of bytes
+/// @details Cheap and good enough for lookup tables and cache keys; not for anything adversarial.
+/// @param seed Pass a previous result to hash several blocks as one stream
+constexpr uint64_t fnv1a(const char *data, size_t length, uint64_t seed = 14695981039346656037ull) {
+    uint64_t hash = seed;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/// @brief 64-bit FNV-1a hash of a string
+inline uint64_t fnv1a(const std::string &text, uint64_t seed = 14695981039346656037ull) {
+    return fnv1a(text.data(), text.size(), seed);
+}
+
+#endif //GRAPHICS_HASH_H
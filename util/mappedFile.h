@@ -0,0 +1,34 @@
+#ifndef GRAPHICS_MAPPEDFILE_H
+#define GRAPHICS_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/// @brief A whole file mapped read-only into memory (POSIX mmap), unmapped on destruction
+/// @details Pages are read in by the OS as they are touched, so nothing is copied up front.
+class MappedFile {
+    public:
+        /// @brief Maps the file at path; check isOpen() afterwards
+        explicit MappedFile(const std::string &path);
+
+        /// @brief Unmaps the file
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @brief False if the file doesn't exist, is empty or couldn't be mapped
+        bool isOpen() const;
+
+        /// @brief The first byte of the file
+        const unsigned char* data() const;
+
+        /// @brief Size of the file in bytes
+        size_t size() const;
+
+    private:
+        void* mapping = nullptr;
+        size_t length = 0;
+};
+
+#endif //GRAPHICS_MAPPEDFILE_H
@@ -0,0 +1,89 @@
+#ifndef GRAPHICS_RANDOM_H
+#define GRAPHICS_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief The independent sequences the game draws from, one per kind of decision
+/// @details Each gets its own Pcg32 stream, so drawing more of one (say, extra colors) never shifts
+/// what another (the positions) produces for the same seed. A new kind of random decision gets a new value.
+enum class RandomStream : uint64_t { Position = 1, Color = 2 };
+
+/**
+ * @brief PCG32 pseudo-random generator (O'Neill's PCG-XSH-RR, 64-bit state, 32-bit output)
+ * @details Small, fast and statistically sound, with explicit seeding: the same seed and stream always
+ * produce the same sequence, on every platform. Different streams with the same seed are independent
+ * sequences. Bounded draws use Lemire's multiply-and-reject method, so they are unbiased (unlike
+ * rand() % n) and almost never divide. Not for anything cryptographic.
+ */
+class Pcg32 {
+    public:
+        /**
+         * @brief Construct a new Pcg32 object
+         *
+         * @param seed The starting point of the sequence
+         * @param stream Which of the 2^63 independent sequences to use
+         */
+        explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bull, uint64_t stream = 0xda3e39cb94b95bdbull) {
+            this->seed(seed, stream);
+        }
+
+        /// @brief Restarts the generator at the beginning of a sequence
+        void seed(uint64_t seed, uint64_t stream) {
+            state = 0;
+            increment = (stream << 1u) | 1u;
+            next();
+            state += seed;
+            next();
+        }
+
+        /// @brief A uniformly distributed 32-bit value
+        uint32_t next() {
+            uint64_t old = state;
+            state = old * 6364136223846793005ull + increment;
+            uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+            uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+            return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+        }
+
+        /// @brief A uniformly distributed value in [0, bound), 0 if bound is 0
+        uint32_t below(uint32_t bound) {
+            uint64_t product = static_cast<uint64_t>(next()) * bound;
+            uint32_t low = static_cast<uint32_t>(product);
+            if (low < bound) {
+                // reject the few low values that would make some results more likely; the modulo
+                // only runs in this rare branch
+                uint32_t threshold = -bound % bound;
+                while (low < threshold) {
+                    product = static_cast<uint64_t>(next()) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            return static_cast<uint32_t>(product >> 32u);
+        }
+
+        /// @brief A uniformly distributed float in [0, 1)
+        float uniform() {
+            // the top 24 bits, exactly representable in a float
+            return static_cast<float>(next() >> 8u) * 0x1.0p-24f;
+        }
+
+        /// @brief Fills values with draws from [0, bound)
+        void fill(uint32_t* values, size_t count, uint32_t bound) {
+            for (size_t i = 0; i < count; i++)
+                values[i] = below(bound);
+        }
+
+        /// @brief Fills values with draws from [0, 1)
+        void fill(float* values, size_t count) {
+            for (size_t i = 0; i < count; i++)
+                values[i] = uniform();
+        }
+
+    private:
+        uint64_t state = 0;
+        /// @brief Selects the stream, always odd
+        uint64_t increment = 1;
+};
+
+#endif //GRAPHICS_RANDOM_H
@@ -0,0 +1,73 @@
+#ifndef GRAPHICS_SPSCQUEUE_H
+#define GRAPHICS_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Wait-free bounded ring buffer for one producer thread and one consumer thread
+ * @details push() and peek()/pop() never block and never allocate: the slots live inside the queue.
+ * Each side keeps a cached copy of the other side's index and only reloads the shared atomic when
+ * the cache says the ring is full (producer) or empty (consumer), so in the common case neither
+ * side touches the other's cache line.
+ *
+ * @tparam T A copyable element type
+ * @tparam Capacity Number of slots, a power of two
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    public:
+        /**
+         * @brief Appends a value (producer thread only)
+         *
+         * @return false if the ring is full and the value was dropped
+         */
+        bool push(const T& value) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            if (position - headCache == Capacity) {
+                headCache = head.load(std::memory_order_acquire);
+                if (position - headCache == Capacity)
+                    return false;
+            }
+            slots[position & MASK] = value;
+            tail.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief The oldest value, left in the queue (consumer thread only)
+         *
+         * @return nullptr if the queue is empty; otherwise valid until pop()
+         */
+        const T* peek() {
+            size_t position = head.load(std::memory_order_relaxed);
+            if (position == tailCache) {
+                tailCache = tail.load(std::memory_order_acquire);
+                if (position == tailCache)
+                    return nullptr;
+            }
+            return &slots[position & MASK];
+        }
+
+        /// @brief Removes the value peek() returned (consumer thread only)
+        void pop() {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        /// @brief Next slot to read, and the consumer's copy of tail
+        alignas(64) std::atomic<size_t> head{0};
+        size_t tailCache = 0;
+
+        /// @brief Next slot to write, and the producer's copy of head
+        alignas(64) std::atomic<size_t> tail{0};
+        size_t headCache = 0;
+
+        alignas(64) T slots[Capacity];
+};
+
+#endif //GRAPHICS_SPSCQUEUE_H
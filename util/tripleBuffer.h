@@ -0,0 +1,68 @@
+#ifndef GRAPHICS_TRIPLEBUFFER_H
+#define GRAPHICS_TRIPLEBUFFER_H
+
+#include <atomic>
+
+/**
+ * @brief Lock-free hand-off of the latest value from one writer thread to one reader thread
+ * @details Three slots: the writer fills its back slot and publish() swaps it with the middle one;
+ * the reader's update() swaps its front slot with the middle one if something new was published.
+ * Neither side ever waits, the reader always gets the newest complete value, and values the reader
+ * was too slow to see are simply overwritten.
+ *
+ * The slots are reused, so a writer must overwrite everything in back() before publishing it
+ * (containers keep their capacity, so this doesn't allocate once they have grown).
+ */
+template <typename T>
+class TripleBuffer {
+    public:
+        /// @brief The slot the writer fills (writer thread only)
+        T& back() { return slots[backIndex]; }
+
+        /// @brief Makes the back slot the newest value and hands the writer a free slot (writer thread only)
+        void publish() {
+            unsigned previous = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel);
+            backIndex = previous & INDEX;
+        }
+
+        /// @brief True if a value was published since the last update() (reader thread only)
+        bool hasFresh() const {
+            return (middle.load(std::memory_order_relaxed) & FRESH) != 0;
+        }
+
+        /**
+         * @brief Takes the newest published value, if there is one (reader thread only)
+         * @details The previous front slot is handed back to the writer, so copy anything still
+         * needed from front() before calling this.
+         *
+         * @return true if front() changed
+         */
+        bool update() {
+            if (!hasFresh())
+                return false;
+            unsigned previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & INDEX;
+            return true;
+        }
+
+        /// @brief The value the reader holds (reader thread only)
+        const T& front() const { return slots[frontIndex]; }
+
+    private:
+        /// @brief Set on the middle index while it holds a value the reader hasn't taken
+        static constexpr unsigned FRESH = 4;
+        static constexpr unsigned INDEX = 3;
+
+        T slots[3]{};
+
+        /// @brief Owned by the writer
+        unsigned backIndex = 0;
+
+        /// @brief Shared; on its own cache line so the writer's and reader's slots don't false-share with it
+        alignas(64) std::atomic<unsigned> middle{1};
+
+        /// @brief Owned by the reader
+        alignas(64) unsigned frontIndex = 2;
+};
+
+#endif //GRAPHICS_TRIPLEBUFFER_H
@@ -0,0 +1,39 @@
+#ifndef GRAPHICS_UTF8_H
+#define GRAPHICS_UTF8_H
+
+#include <string>
+
+/// @brief Decodes the UTF-8 sequence starting at text[i] and advances i past it
+/// @details Malformed, truncated or overlong sequences decode to U+FFFD (replacement character)
+/// and consume a single byte, so decoding always makes progress.
+inline char32_t nextCodepoint(const std::string &text, size_t &i) {
+    const char32_t replacement = 0xFFFD;
+    unsigned char lead = text[i++];
+    if (lead < 0x80)
+        return lead;
+
+    int length;
+    char32_t codepoint;
+    if ((lead & 0xE0) == 0xC0)      { length = 1; codepoint = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { length = 2; codepoint = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { length = 3; codepoint = lead & 0x07; }
+    else return replacement;
+
+    if (i + length > text.size())
+        return replacement;
+    for (int k = 0; k < length; k++) {
+        unsigned char next = text[i + k];
+        if ((next & 0xC0) != 0x80)
+            return replacement;
+        codepoint = codepoint << 6 | (next & 0x3F);
+    }
+
+    // reject overlong encodings, surrogates and values past the Unicode range
+    static const char32_t minimum[] = {0, 0x80, 0x800, 0x10000};
+    if (codepoint < minimum[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+        return replacement;
+    i += length;
+    return codepoint;
+}
+
+#endif //GRAPHICS_UTF8_H